@@ -0,0 +1,166 @@
+#include "DagExecutor.hpp"
+#include "Parallel.hpp"
+#include "structures/graph/TopoSort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Owner pushes / pops at the back, thieves take from the front.
+struct WorkQueue {
+    std::mutex m;
+    std::deque<int> q;
+};
+
+class Run {
+public:
+    Run(const Graph& g, const std::vector<std::function<void()>>& task, unsigned threads,
+        DagExecutor::Report& rep)
+        : g_(g), task_(task), queues_(threads), indeg_(g.V()), rep_(rep) {
+        for (auto& q : queues_) q = std::make_unique<WorkQueue>();
+        for (int v=0; v<g.V(); v++) indeg_[v].store(0, std::memory_order_relaxed);
+        for (int u=0; u<g.V(); u++) {
+            for (auto e : g.neighbors(u)) indeg_[e.to].fetch_add(1, std::memory_order_relaxed);
+        }
+        remaining_ = g.V();
+        // sources dealt round-robin so every thread starts with work
+        unsigned next = 0;
+        for (int v=0; v<g.V(); v++) {
+            if (indeg_[v].load(std::memory_order_relaxed) == 0) {
+                queues_[next++ % threads]->q.push_back(v);
+                ready_++;
+            }
+        }
+    }
+
+    void execute() {
+        t0_ = Clock::now();
+        std::vector<std::thread> helpers;
+        for (unsigned i=1; i<queues_.size(); i++) helpers.emplace_back([this, i]{ worker(i); });
+        worker(0);
+        for (auto& t : helpers) t.join();
+        rep_.wallMs = ms(Clock::now());
+        rep_.steals = steals_.load();
+    }
+
+private:
+    const Graph& g_;
+    const std::vector<std::function<void()>>& task_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::atomic<int>> indeg_;
+    DagExecutor::Report& rep_;
+    Clock::time_point t0_;
+
+    std::atomic<int> remaining_{0};   // tasks not finished yet
+    std::atomic<int> ready_{0};       // tasks sitting in some queue
+    std::atomic<long long> steals_{0};
+    std::mutex idleM_;
+    std::condition_variable idle_;
+
+    double ms(Clock::time_point t) const { return std::chrono::duration<double, std::milli>(t - t0_).count(); }
+
+    bool take(unsigned self, int& v) {
+        {
+            auto& mine = *queues_[self];
+            std::lock_guard<std::mutex> lk(mine.m);
+            if (!mine.q.empty()) { v = mine.q.back(); mine.q.pop_back(); ready_--; return true; }
+        }
+        for (unsigned k=1; k<queues_.size(); k++) {
+            auto& other = *queues_[(self + k) % queues_.size()];
+            std::lock_guard<std::mutex> lk(other.m);
+            if (!other.q.empty()) {
+                v = other.q.front();
+                other.q.pop_front();
+                ready_--;
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(unsigned self) {
+        int v;
+        while (true) {
+            if (!take(self, v)) {
+                std::unique_lock<std::mutex> lk(idleM_);
+                idle_.wait(lk, [&]{ return ready_.load() > 0 || remaining_.load() == 0; });
+                if (remaining_.load() == 0) break;
+                continue;
+            }
+
+            auto start = Clock::now();
+            task_[v]();
+            auto end = Clock::now();
+            rep_.tasks[v] = {ms(start), ms(end), static_cast<int>(self)};
+
+            int released = 0;
+            {
+                auto& mine = *queues_[self];
+                std::lock_guard<std::mutex> lk(mine.m);
+                for (auto e : g_.neighbors(v)) {
+                    if (indeg_[e.to].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        mine.q.push_back(e.to);
+                        released++;
+                    }
+                }
+                ready_ += released;
+            }
+            // one released task stays with this thread; wake others for the rest
+            bool last = remaining_.fetch_sub(1) == 1;
+            if (released > 1 || last) {
+                std::lock_guard<std::mutex> lk(idleM_); // no missed wake-up between check and wait()
+                idle_.notify_all();
+            }
+        }
+    }
+};
+
+}
+
+namespace DagExecutor {
+
+Report run(const Graph& g, const std::vector<std::function<void()>>& task, unsigned threads) {
+    if (!g.directed()) throw std::invalid_argument("DagExecutor: graph must be directed");
+    if ((int)task.size() != g.V()) throw std::invalid_argument("DagExecutor: one task per node");
+
+    Report rep;
+    auto topo = TopoSort::kahn(g);
+    if (!topo.isDAG) return rep;
+    rep.isDAG = true;
+    rep.threads = threads ? threads : Parallel::threadCount();
+    rep.tasks.assign(g.V(), {});
+    if (g.V() == 0) return rep;
+
+    Run r(g, task, rep.threads, rep);
+    r.execute();
+
+    // longest chain of measured durations, in topological order
+    std::vector<double> finish(g.V(), 0.0);
+    std::vector<int> via(g.V(), -1);
+    int last = -1;
+    for (int u : topo.order) {
+        double d = rep.tasks[u].endMs - rep.tasks[u].startMs;
+        rep.workMs += d;
+        finish[u] += d; // holds the best predecessor chain so far
+        if (last < 0 || finish[u] > finish[last]) last = u;
+        for (auto e : g.neighbors(u)) {
+            if (finish[u] > finish[e.to]) { finish[e.to] = finish[u]; via[e.to] = u; }
+        }
+    }
+    rep.criticalPathMs = finish[last];
+    for (int v=last; v!=-1; v=via[v]) rep.criticalPath.push_back(v);
+    std::reverse(rep.criticalPath.begin(), rep.criticalPath.end());
+    return rep;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "structures/graph/Graph.hpp"
+
+// Runs a job DAG with as much parallelism as the dependencies allow.
+// Edge u -> v means task v needs task u. Tasks are released Kahn-style
+// (in-degree reaches zero) onto per-thread deques: a thread runs the
+// newest task it released itself, and idle threads steal the oldest from
+// the others.
+namespace DagExecutor {
+    struct TaskTime {
+        double startMs{0}; // since run() started
+        double endMs{0};
+        int thread{-1};
+    };
+
+    struct Report {
+        bool isDAG{false};           // nothing runs on a cyclic graph
+        unsigned threads{0};
+        double wallMs{0};
+        double workMs{0};            // sum of task durations
+        double criticalPathMs{0};    // longest dependency chain, by measured durations
+        std::vector<int> criticalPath;
+        std::vector<TaskTime> tasks; // per node id
+        long long steals{0};
+
+        double parallelism() const { return wallMs > 0 ? workMs / wallMs : 0; }                // achieved
+        double maxParallelism() const { return criticalPathMs > 0 ? workMs / criticalPathMs : 0; } // available
+    };
+
+    // task[v] runs once, after every predecessor has finished. threads = 0
+    // uses Parallel::threadCount(). Tasks may use Parallel::forRange but
+    // must not throw.
+    Report run(const Graph& g, const std::vector<std::function<void()>>& task, unsigned threads = 0);
+}
@@ -0,0 +1,130 @@
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+thread_local bool tInWorker = false;
+
+class Pool {
+public:
+    explicit Pool(unsigned workers) {
+        for (unsigned i=0;i<workers;i++) threads_.emplace_back([this]{ workerLoop(); });
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    unsigned size() const { return static_cast<unsigned>(threads_.size()) + 1; }
+
+    void run(std::size_t n, std::size_t grain,
+             const std::function<void(std::size_t, std::size_t)>& fn) {
+        std::lock_guard<std::mutex> submit(submit_); // one job at a time
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            fn_ = &fn;
+            n_ = n;
+            grain_ = grain;
+            chunks_ = (n + grain - 1) / grain;
+            finished_ = 0;
+            next_.store(0, std::memory_order_relaxed);
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lk(m_);
+        done_.wait(lk, [&]{ return finished_ == chunks_ && active_ == 0; });
+        fn_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex submit_;
+    std::mutex m_;
+    std::condition_variable wake_, done_;
+
+    const std::function<void(std::size_t, std::size_t)>* fn_{nullptr};
+    std::size_t n_{0}, grain_{1}, chunks_{0}, finished_{0};
+    std::atomic<std::size_t> next_{0};
+    unsigned long long generation_{0};
+    int active_{0};
+    bool stop_{false};
+
+    void runChunks() {
+        std::size_t mine = 0;
+        while (true) {
+            std::size_t c = next_.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunks_) break;
+            std::size_t b = c * grain_;
+            (*fn_)(b, std::min(n_, b + grain_));
+            ++mine;
+        }
+        if (mine == 0) return;
+        std::lock_guard<std::mutex> lk(m_);
+        finished_ += mine;
+        if (finished_ == chunks_) done_.notify_all();
+    }
+
+    void workerLoop() {
+        tInWorker = true;
+        unsigned long long seen = 0;
+        std::unique_lock<std::mutex> lk(m_);
+        while (true) {
+            wake_.wait(lk, [&]{ return stop_ || (fn_ && generation_ != seen); });
+            if (stop_) return;
+            seen = generation_;
+            ++active_;
+            lk.unlock();
+            runChunks();
+            lk.lock();
+            if (--active_ == 0) done_.notify_all();
+        }
+    }
+};
+
+unsigned configuredThreads() {
+    if (const char* env = std::getenv("ALGOCITY_THREADS")) {
+        int n = std::atoi(env);
+        if (n > 0) return static_cast<unsigned>(n);
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+Pool& pool() {
+    static Pool p(configuredThreads() - 1);
+    return p;
+}
+
+}
+
+namespace Parallel {
+
+unsigned threadCount() {
+    return pool().size();
+}
+
+void forRange(std::size_t n, std::size_t grain,
+              const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (n == 0) return;
+    if (grain == 0) grain = 1;
+    if (n <= grain || tInWorker || threadCount() == 1) {
+        fn(0, n);
+        return;
+    }
+    pool().run(n, grain, fn);
+}
+
+}
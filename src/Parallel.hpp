@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// Tiny shared worker pool for data-parallel loops (BFS frontiers, batch
+// queries, block compression...). One pool per process, created lazily.
+namespace Parallel {
+    // Threads that take part in a forRange() call (workers + caller), >= 1.
+    // Defaults to the hardware concurrency; ALGOCITY_THREADS overrides it.
+    unsigned threadCount();
+
+    // Runs fn(begin, end) over [0, n) in chunks of `grain` items and blocks
+    // until all chunks are done. Small ranges, single-core machines and
+    // nested calls from inside a worker simply run inline.
+    // fn must not throw.
+    void forRange(std::size_t n, std::size_t grain,
+                  const std::function<void(std::size_t, std::size_t)>& fn);
+}
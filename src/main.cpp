@@ -1,13 +1,15 @@
 #include <iostream>
 #include <string>
 #include <limits>
-#include <fstream>
 #include <sstream>
+#include <cstdlib>
 #include "modules/CitizenDB.hpp"
 #include "modules/CityMap.hpp"
 #include "modules/Emergency.hpp"
 #include "modules/FileIO.hpp"
-#include "structures/graph/TopoSort.hpp"
+#include "modules/Benchmarks.hpp"
+#include "modules/RoutingCluster.hpp"
+#include "modules/ConstructionPlanner.hpp"
 
 static void flushLine() {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -25,6 +27,18 @@ static int readInt(const std::string& prompt) {
     return x;
 }
 
+static double readDouble(const std::string& prompt) {
+    double x;
+    std::cout << prompt;
+    while (!(std::cin >> x)) {
+        std::cin.clear();
+        flushLine();
+        std::cout << "Enter a number: ";
+    }
+    flushLine();
+    return x;
+}
+
 static std::string readLine(const std::string& prompt) {
     std::cout << prompt;
     std::string s;
@@ -32,37 +46,30 @@ static std::string readLine(const std::string& prompt) {
     return s;
 }
 
-static void runTopoFromFile(const std::string& path) {
-    Graph tasks(true);
-    std::ifstream f(path);
-    if (!f) { std::cout << "Failed to open: " << path << "\n"; return; }
-
-    std::string line;
-    int edges = 0;
-    while (std::getline(f, line)) {
-        if (line.empty()) continue;
-        std::stringstream ss(line);
-        std::string pre, task;
-        if (!std::getline(ss, pre, ';')) continue;
-        if (!std::getline(ss, task, ';')) continue;
-        tasks.addEdge(pre, task, 1);
-        edges++;
+// "a, b ,c" -> {"a","b","c"}
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        auto b = item.find_first_not_of(' ');
+        auto e = item.find_last_not_of(' ');
+        if (b == std::string::npos) continue;
+        out.push_back(item.substr(b, e - b + 1));
     }
-    std::cout << "Loaded tasks: " << edges << " deps, " << tasks.V() << " tasks.\n";
+    return out;
+}
 
-    auto res = TopoSort::kahn(tasks);
-    if (!res.isDAG) {
-        std::cout << "Cannot topo-sort: cycle detected.\n";
-        return;
+int main(int argc, char** argv) {
+    // worker process spawned by RoutingCluster::start()
+    if (argc == 4 && std::string(argv[1]) == "--route-worker") {
+        return RoutingCluster::workerMain(std::atoi(argv[2]), argv[3]);
     }
-    std::cout << "Valid construction order:\n";
-    for (int id : res.order) std::cout << " - " << tasks.nodeName(id) << "\n";
-}
 
-int main() {
     CitizenDB citizens;
     CityMap city;
     EmergencySystem emergency;
+    ConstructionPlanner planner;
 
     while (true) {
         std::cout << "\n=== AlgoCity ===\n"
@@ -71,6 +78,7 @@ int main() {
                   << "3) Emergency Response\n"
                   << "4) Construction Planner (Topo Sort)\n"
                   << "5) Save/Load demo (Huffman)\n"
+                  << "6) Benchmarks\n"
                   << "0) Exit\n";
 
         int choice = readInt("Choose: ");
@@ -111,14 +119,28 @@ int main() {
                       << "2) Add road\n"
                       << "3) BFS from location\n"
                       << "4) Shortest path (Dijkstra)\n"
-                      << "5) Optimize power grid (Prim MST)\n";
+                      << "5) Optimize power grid (MST)\n"
+                      << "6) Distance table (many-to-many)\n"
+                      << "7) Route cache stats\n"
+                      << "8) Close road\n"
+                      << "9) Change road length\n"
+                      << "10) Track frequent origin\n"
+                      << "11) Save map snapshot (data/city_layout.bin)\n"
+                      << "12) Load map snapshot (data/city_layout.bin)\n"
+                      << "13) Optimize node layout (Hilbert curve / RCM)\n"
+                      << "14) Reachable within distance (isochrone)\n"
+                      << "15) Nearest facilities\n"
+                      << "16) Nearest location to coordinates\n"
+                      << "17) Locations in area\n"
+                      << "18) Start routing cluster (worker processes)\n"
+                      << "19) Shortest path via routing cluster\n";
             int c = readInt("Choose: ");
             if (c == 1) city.loadRoads("data/city_layout.txt");
             else if (c == 2) {
                 std::string a = readLine("From: ");
                 std::string b = readLine("To: ");
                 int w = readInt("Distance: ");
-                city.addRoad(a, b, w);
+                if (!city.addRoad(a, b, w)) std::cout << "Distance cannot be negative.\n";
             } else if (c == 3) {
                 std::string s = readLine("Start location: ");
                 city.bfsFrom(s);
@@ -127,8 +149,77 @@ int main() {
                 std::string b = readLine("To: ");
                 city.shortestPath(a, b);
             } else if (c == 5) {
-                std::string s = readLine("Start (power plant): ");
-                city.optimizePowerGrid(s);
+                int e = readInt("Engine (1=Prim, 2=Kruskal, 3=Boruvka): ");
+                if (e == 2) city.optimizePowerGrid("", CityMap::GridEngine::Kruskal);
+                else if (e == 3) city.optimizePowerGrid("", CityMap::GridEngine::Boruvka);
+                else {
+                    std::string s = readLine("Start (power plant): ");
+                    city.optimizePowerGrid(s);
+                }
+            } else if (c == 6) {
+                auto from = splitList(readLine("Sources (comma separated): "));
+                auto to = splitList(readLine("Targets (comma separated): "));
+                city.printDistanceTable(from, to);
+            } else if (c == 7) {
+                city.printRouteCacheStats();
+            } else if (c == 8) {
+                std::string a = readLine("From: ");
+                std::string b = readLine("To: ");
+                std::cout << (city.closeRoad(a, b) ? "Road closed.\n" : "No such road.\n");
+            } else if (c == 9) {
+                std::string a = readLine("From: ");
+                std::string b = readLine("To: ");
+                int w = readInt("New distance: ");
+                if (w < 0) std::cout << "Distance cannot be negative.\n";
+                else std::cout << (city.setRoadLength(a, b, w) ? "Road updated.\n" : "No such road.\n");
+            } else if (c == 10) {
+                std::string s = readLine("Origin: ");
+                std::cout << (city.trackSource(s) ? "Tracking shortest paths from " + s + ".\n"
+                                                  : "Unknown location.\n");
+            } else if (c == 11) {
+                city.saveRoadsBinary("data/city_layout.bin");
+            } else if (c == 12) {
+                city.loadRoadsBinary("data/city_layout.bin");
+            } else if (c == 13) {
+                city.optimizeLayout();
+                std::cout << "Node ids renumbered.\n";
+            } else if (c == 14) {
+                std::string s = readLine("Start location: ");
+                int budget = readInt("Max distance: ");
+                if (!city.graph().nodeIdOpt(s)) {
+                    std::cout << "Unknown location.\n";
+                } else {
+                    auto reach = city.isochrone(s, budget);
+                    if (reach.empty()) std::cout << "Nothing reachable within that distance.\n";
+                    for (const auto& r : reach) std::cout << " - " << r.first << " (" << r.second << ")\n";
+                }
+            } else if (c == 15) {
+                std::string s = readLine("Start location: ");
+                auto facilities = splitList(readLine("Facilities (comma separated): "));
+                int k = readInt("How many: ");
+                auto hits = city.nearestFacilities(s, facilities, k);
+                if (hits.empty()) std::cout << "None reachable.\n";
+                for (const auto& h : hits) std::cout << " - " << h.first << " (" << h.second << ")\n";
+            } else if (c == 16) {
+                double x = readDouble("X: ");
+                double y = readDouble("Y: ");
+                auto name = city.nearestLocation(x, y);
+                std::cout << (name ? "Nearest location: " + *name + "\n" : "No located intersections.\n");
+            } else if (c == 17) {
+                double x1 = readDouble("Min X: ");
+                double y1 = readDouble("Min Y: ");
+                double x2 = readDouble("Max X: ");
+                double y2 = readDouble("Max Y: ");
+                auto names = city.locationsInBox(x1, y1, x2, y2);
+                if (names.empty()) std::cout << "Nothing in that area.\n";
+                for (const auto& n : names) std::cout << " - " << n << "\n";
+            } else if (c == 18) {
+                int k = readInt("Regions: ");
+                if (!city.startRoutingCluster(k)) std::cout << "Could not start routing cluster.\n";
+            } else if (c == 19) {
+                std::string a = readLine("From: ");
+                std::string b = readLine("To: ");
+                city.clusterShortestPath(a, b);
             }
         }
 
@@ -150,13 +241,27 @@ int main() {
         }
 
         else if (choice == 4) {
-            runTopoFromFile("data/construction_tasks.txt");
+            std::cout << "\nConstruction Planner\n"
+                      << "1) Load from data/construction_tasks.txt\n"
+                      << "2) Add dependency\n"
+                      << "3) Show construction order\n"
+                      << "4) Simulate construction (parallel executor)\n";
+            int c = readInt("Choose: ");
+            if (c == 1) planner.loadTasks("data/construction_tasks.txt");
+            else if (c == 2) {
+                std::string pre = readLine("Prerequisite: ");
+                std::string task = readLine("Task: ");
+                if (planner.addDependency(pre, task)) std::cout << "Added.\n";
+            } else if (c == 3) planner.printOrder();
+            else if (c == 4) planner.simulate();
         }
 
         else if (choice == 5) {
             std::cout << "\nHuffman Save/Load demo\n"
                       << "1) Save sample text (compressed)\n"
-                      << "2) Load sample text (decompress)\n";
+                      << "2) Load sample text (decompress)\n"
+                      << "3) Compress a file (streaming, any size)\n"
+                      << "4) Decompress a file\n";
             int c = readInt("Choose: ");
             if (c == 1) {
                 std::string text =
@@ -169,8 +274,45 @@ int main() {
                 std::string text = FileIO::loadCompressedText("data/city_state.huf");
                 if (text.empty()) std::cout << "Load failed.\n";
                 else std::cout << "Decompressed text:\n" << text << "\n";
+            } else if (c == 3) {
+                std::string from = readLine("File to compress: ");
+                std::string to = readLine("Write archive to: ");
+                std::cout << (FileIO::compressFile(from, to) ? "Compressed.\n" : "Compression failed.\n");
+            } else if (c == 4) {
+                std::string from = readLine("Archive: ");
+                std::string to = readLine("Write file to: ");
+                std::cout << (FileIO::decompressFile(from, to) ? "Decompressed.\n" : "Decompression failed.\n");
             }
         }
+
+        else if (choice == 6) {
+            std::cout << "\nBenchmarks\n"
+                      << "1) MST engines (Prim / Kruskal / Boruvka)\n"
+                      << "2) Road network loading (text / binary / mmap)\n"
+                      << "3) Node ordering (shuffled vs RCM)\n"
+                      << "4) Short queries (search workspace reuse)\n"
+                      << "5) GPS point snapping (k-d tree)\n"
+                      << "6) DAG executor (task graph)\n"
+                      << "7) Hash tables (HashTable vs std::unordered_map)\n"
+                      << "8) Hash functions (FNV-1a vs word-at-a-time)\n"
+                      << "9) Concurrent lookups (global lock vs sharded table)\n"
+                      << "10) Frozen name lookups (HashTable vs perfect hash)\n"
+                      << "11) Huffman compression (city logs)\n"
+                      << "12) Routing cluster (cross-checked against Dijkstra)\n";
+            int c = readInt("Choose: ");
+            if (c == 1) Benchmarks::mstEngines(readInt("Nodes: "));
+            else if (c == 2) Benchmarks::graphLoading(readInt("Nodes: "));
+            else if (c == 3) Benchmarks::nodeOrdering(readInt("Nodes: "));
+            else if (c == 4) Benchmarks::shortQueries(readInt("Nodes: "));
+            else if (c == 5) Benchmarks::pointSnapping(readInt("Nodes: "));
+            else if (c == 6) Benchmarks::dagExecutor(readInt("Tasks: "));
+            else if (c == 7) Benchmarks::hashTables(readInt("Keys: "));
+            else if (c == 8) Benchmarks::hashFunctions(readInt("Keys: "));
+            else if (c == 9) Benchmarks::concurrentLookups(readInt("Keys: "));
+            else if (c == 10) Benchmarks::nameLookups(readInt("Keys: "));
+            else if (c == 11) Benchmarks::huffman(readInt("Megabytes: "));
+            else if (c == 12) Benchmarks::routingCluster(readInt("Nodes: "));
+        }
     }
 
     std::cout << "Bye!\n";
@@ -0,0 +1,576 @@
+#include "modules/Benchmarks.hpp"
+#include "modules/CityMap.hpp"
+#include "modules/FileIO.hpp"
+#include "modules/RoutingCluster.hpp"
+#include "structures/graph/Algorithms.hpp"
+#include "structures/graph/GraphFile.hpp"
+#include "structures/tree/KDTree.hpp"
+#include "structures/tree/Huffman.hpp"
+#include "structures/hash/HashTable.hpp"
+#include "structures/hash/ConcurrentHashTable.hpp"
+#include "structures/hash/PerfectHash.hpp"
+#include "Parallel.hpp"
+#include "DagExecutor.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <random>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+template <typename Fn>
+static long long timeMs(Fn&& fn) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    fn();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+}
+
+// Hardware cache-miss counter for the calling thread; -1 when perf events
+// are unavailable (non-Linux, containers, perf_event_paranoid...).
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+#if defined(__linux__)
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    int fd_{-1};
+};
+
+// Connected, road-like sparse graph: a chain plus ~2 short-range links per
+// node, random lengths 1..100.
+static void buildRoadNetwork(Graph& g, int nodes, unsigned seed) {
+    std::mt19937 rng(seed);
+    for (int i=0; i<nodes; i++) g.addNode("n" + std::to_string(i));
+    for (int i=0; i<nodes; i++) {
+        const std::string a = "n" + std::to_string(i);
+        if (i + 1 < nodes) g.addEdge(a, "n" + std::to_string(i + 1), 1 + rng() % 100);
+        for (int k=0; k<2; k++) {
+            int j = static_cast<int>((i + 1 + rng() % 64) % nodes);
+            if (j != i) g.addEdge(a, "n" + std::to_string(j), 1 + rng() % 100);
+        }
+    }
+}
+
+// Mean |u - v| over all adjacency entries: a cheap locality proxy.
+static double meanIdGap(const Graph& g) {
+    long double sum = 0;
+    long long cnt = 0;
+    for (int u=0; u<g.V(); u++) {
+        for (auto e : g.neighbors(u)) { sum += std::abs(e.to - u); cnt++; }
+    }
+    return cnt ? static_cast<double>(sum / cnt) : 0.0;
+}
+
+static void runQueries(const Graph& g, const std::vector<std::string>& probes, const char* label) {
+    CacheMissCounter misses;
+    misses.start();
+    long long ms = timeMs([&]{
+        for (std::size_t i=0; i+1<probes.size(); i+=2) {
+            Algorithms::dijkstra(g, g.nodeId(probes[i]), g.nodeId(probes[i + 1]));
+            Algorithms::bfsLevels(g, g.nodeId(probes[i]));
+        }
+    });
+    long long m = misses.stop();
+    std::cout << label << ": mean id gap=" << meanIdGap(g) << ", queries " << ms << " ms, cache misses=";
+    if (m < 0) std::cout << "n/a";
+    else std::cout << m;
+    std::cout << "\n";
+}
+
+namespace Benchmarks {
+
+void mstEngines(int nodes) {
+    if (nodes < 2) { std::cout << "Need at least 2 nodes.\n"; return; }
+    Graph g(false);
+    long long buildMs = timeMs([&]{ buildRoadNetwork(g, nodes, 42); });
+
+    long long edges = 0;
+    for (int u=0; u<g.V(); u++) edges += static_cast<long long>(g.neighbors(u).size());
+    std::cout << "Graph: " << g.V() << " nodes, " << edges / 2 << " edges (built in "
+              << buildMs << " ms), threads=" << Parallel::threadCount() << "\n";
+
+    Algorithms::MSTResult prim, kruskal, boruvka;
+    long long primMs = timeMs([&]{ prim = Algorithms::primMST(g, 0); });
+    long long kruskalMs = timeMs([&]{ kruskal = Algorithms::kruskalMST(g); });
+    long long boruvkaMs = timeMs([&]{ boruvka = Algorithms::boruvkaMST(g); });
+
+    std::cout << "Prim:    " << primMs << " ms, cost=" << prim.totalCost << "\n";
+    std::cout << "Kruskal: " << kruskalMs << " ms, cost=" << kruskal.totalCost << "\n";
+    std::cout << "Boruvka: " << boruvkaMs << " ms, cost=" << boruvka.totalCost << "\n";
+    if (prim.totalCost != kruskal.totalCost || kruskal.totalCost != boruvka.totalCost) {
+        std::cout << "WARNING: engines disagree on the MST cost.\n";
+    }
+}
+
+void graphLoading(int nodes) {
+    if (nodes < 2) { std::cout << "Need at least 2 nodes.\n"; return; }
+    const std::string txt = "data/bench_roads.txt", bin = "data/bench_roads.bin";
+    {
+        Graph g(false);
+        buildRoadNetwork(g, nodes, 42);
+        std::ofstream f(txt);
+        for (int u=0; u<g.V(); u++) {
+            for (auto e : g.neighbors(u)) {
+                if (e.to > u) f << g.nodeName(u) << ';' << g.nodeName(e.to) << ';' << e.w << '\n';
+            }
+        }
+        g.saveBinary(bin);
+    }
+
+    CityMap fromText, fromBinary;
+    long long textMs = timeMs([&]{ fromText.loadRoads(txt); });
+    long long binMs = timeMs([&]{ fromBinary.loadRoadsBinary(bin); });
+    GraphFile::Mapped m;
+    long long mapMs = timeMs([&]{ m.open(bin); });
+
+    std::cout << "Text parse:    " << textMs << " ms\n";
+    std::cout << "Binary load:   " << binMs << " ms (mapped and validated; copied on the first edit)\n";
+    std::cout << "mmap open:     " << mapMs << " ms (" << (m.isOpen() ? m.V() : 0) << " nodes, no parsing)\n";
+    m.close();
+    std::remove(txt.c_str());
+    std::remove(bin.c_str());
+}
+
+void nodeOrdering(int nodes) {
+    if (nodes < 2) { std::cout << "Need at least 2 nodes.\n"; return; }
+    Graph g(false);
+    buildRoadNetwork(g, nodes, 42);
+
+    // random ids, as if names had arrived in arbitrary file order
+    std::vector<int> perm(g.V());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(7));
+    g.renumber(perm);
+
+    std::mt19937 rng(9);
+    std::vector<std::string> probes;
+    for (int i=0; i<20; i++) probes.emplace_back(g.nodeName(static_cast<int>(rng() % g.V())));
+
+    runQueries(g, probes, "Shuffled ids");
+    long long rcmMs = timeMs([&]{ g.renumber(Algorithms::rcmOrder(g)); });
+    std::cout << "RCM renumbering took " << rcmMs << " ms\n";
+    runQueries(g, probes, "RCM ids     ");
+}
+
+void shortQueries(int nodes) {
+    if (nodes < 100) { std::cout << "Need at least 100 nodes.\n"; return; }
+    Graph g(false);
+    buildRoadNetwork(g, nodes, 42);
+
+    // neighbourhood trips: a few hundred nodes apart along the chain
+    std::mt19937 rng(5);
+    std::vector<std::pair<int,int>> trips;
+    for (int i=0; i<2000; i++) {
+        int a = static_cast<int>(rng() % (nodes - 50));
+        trips.push_back({a, a + 1 + static_cast<int>(rng() % 49)});
+    }
+
+    long long sumFresh = 0, sumReused = 0;
+    long long freshMs = timeMs([&]{
+        for (auto t : trips) {
+            SearchWorkspace ws; // O(V) allocation + fill, like a per-call vector
+            sumFresh += Algorithms::dijkstra(g, t.first, t.second, ws).distance;
+        }
+    });
+    long long reusedMs = timeMs([&]{
+        for (auto t : trips) sumReused += Algorithms::dijkstra(g, t.first, t.second).distance;
+    });
+    std::cout << trips.size() << " short queries on " << g.V() << " nodes:\n"
+              << "Fresh scratch per query: " << freshMs << " ms\n"
+              << "Reused workspace:        " << reusedMs << " ms\n";
+    if (sumFresh != sumReused) std::cout << "WARNING: results differ.\n";
+}
+
+void pointSnapping(int nodes) {
+    if (nodes < 1) { std::cout << "Need at least 1 node.\n"; return; }
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(0.0, 10000.0);
+    std::vector<KDTree::Point> located(nodes);
+    for (int i=0; i<nodes; i++) located[i] = {coord(rng), coord(rng), i};
+
+    KDTree tree;
+    long long buildMs = timeMs([&]{ tree.build(located); });
+
+    const int queries = 1000000;
+    std::vector<KDTree::Point> gps(queries);
+    for (auto& p : gps) p = {coord(rng), coord(rng), -1};
+    std::vector<int> snapped;
+    long long snapMs = timeMs([&]{ snapped = tree.nearestBatch(gps); });
+
+    std::cout << "k-d tree over " << nodes << " nodes built in " << buildMs << " ms\n"
+              << queries << " GPS points snapped in " << snapMs << " ms (threads="
+              << Parallel::threadCount() << ")\n";
+}
+
+void dagExecutor(int tasks) {
+    if (tasks < 10) { std::cout << "Need at least 10 tasks.\n"; return; }
+    // layers of ~sqrt(tasks) jobs; each job depends on up to 3 of the previous layer
+    Graph g(true);
+    for (int i=0; i<tasks; i++) g.addNode("job" + std::to_string(i));
+    int width = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(tasks))));
+    std::mt19937 rng(9);
+    for (int v=width; v<tasks; v++) {
+        int layerStart = v / width * width;
+        for (int k=0; k<3; k++) g.addEdge(layerStart - width + static_cast<int>(rng() % width), v, 1);
+    }
+
+    std::vector<double> sink(tasks, 0.0);
+    std::vector<std::function<void()>> work(tasks);
+    for (int v=0; v<tasks; v++) {
+        int spin = 20000 + static_cast<int>(rng() % 40000);
+        work[v] = [&sink, v, spin]{
+            double x = 0;
+            for (int i=1; i<=spin; i++) x += 1.0 / i;
+            sink[v] = x;
+        };
+    }
+
+    for (unsigned threads : {1u, Parallel::threadCount()}) {
+        auto rep = DagExecutor::run(g, work, threads);
+        std::cout << "threads=" << threads << ": " << static_cast<long long>(rep.wallMs) << " ms, work "
+                  << static_cast<long long>(rep.workMs) << " ms, critical path "
+                  << static_cast<long long>(rep.criticalPathMs) << " ms (" << rep.criticalPath.size()
+                  << " jobs), parallelism " << rep.parallelism() << " of " << rep.maxParallelism()
+                  << " available, steals " << rep.steals << "\n";
+        if (threads == Parallel::threadCount()) break;
+    }
+}
+
+void hashTables(int keys) {
+    if (keys < 1) { std::cout << "Need at least 1 key.\n"; return; }
+    std::vector<std::string> names, missing;
+    names.reserve(keys);
+    for (int i=0; i<keys; i++) names.push_back("Intersection " + std::to_string(i) + " & Main St");
+    for (int i=0; i<keys; i++) missing.push_back("Unknown place " + std::to_string(i));
+    std::vector<std::string> probes = names;
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(11));
+
+    long long sumOurs = 0, sumStd = 0;
+    HashTable<int> ours;
+    std::unordered_map<std::string, int> std_;
+    // per-put timing: growth is incremental, so no single insert should stall
+    double worstPutUs = 0;
+    long long oursPut = timeMs([&]{
+        for (int i=0; i<keys; i++) {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            ours.put(names[i], i);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            worstPutUs = std::max(worstPutUs, std::chrono::duration<double, std::micro>(t1 - t0).count());
+        }
+    });
+    long long stdPut = timeMs([&]{ for (int i=0; i<keys; i++) std_[names[i]] = i; });
+    long long oursHit = timeMs([&]{ for (const auto& k : probes) sumOurs += *ours.get(k); });
+    long long stdHit = timeMs([&]{ for (const auto& k : probes) sumStd += std_.find(k)->second; });
+    long long oursMiss = timeMs([&]{ for (const auto& k : missing) sumOurs += ours.contains(k); });
+    long long stdMiss = timeMs([&]{ for (const auto& k : missing) sumStd += std_.count(k); });
+
+    std::cout << keys << " keys              insert   hit lookup   miss lookup (ms)\n"
+              << "HashTable:           " << oursPut << "   " << oursHit << "   " << oursMiss << "\n"
+              << "std::unordered_map:  " << stdPut << "   " << stdHit << "   " << stdMiss << "\n"
+              << "HashTable load factor " << ours.loadFactor() << ", slowest single put "
+              << worstPutUs << " us\n";
+    if (sumOurs != sumStd) std::cout << "WARNING: results differ.\n";
+}
+
+// Max bucket load and share of empty buckets when keys are spread over
+// nextPow2(n) buckets by the low hash bits (how HashTable picks a group).
+template <typename H>
+static void printSpread(const std::vector<std::string>& keys, H hash) {
+    std::size_t buckets = HashUtils::nextPow2(keys.size());
+    std::vector<int> load(buckets, 0);
+    for (const auto& k : keys) load[hash(k) & (buckets - 1)]++;
+    int maxLoad = *std::max_element(load.begin(), load.end());
+    double empty = static_cast<double>(std::count(load.begin(), load.end(), 0)) / static_cast<double>(buckets);
+    std::cout << "  max bucket " << maxLoad << ", empty " << static_cast<int>(empty * 1000) / 10.0 << "%";
+}
+
+// MB/s of pass() over `bytes` bytes; passes repeat until ~100 ms have
+// elapsed, so small key sets still get a measurable time.
+template <typename Fn>
+static double mbPerSec(std::size_t bytes, Fn&& pass) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    long long passes = 0;
+    double sec = 0;
+    do {
+        pass();
+        passes++;
+        sec = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+    } while (sec < 0.1);
+    return static_cast<double>(bytes) * static_cast<double>(passes) / (1024.0 * 1024.0) / sec;
+}
+
+void hashFunctions(int keys) {
+    if (keys < 1) { std::cout << "Need at least 1 key.\n"; return; }
+    static const char* first[] = {"Ava", "Liam", "Noah", "Emma", "Mila", "Sem", "Julia", "Daan", "Yara", "Finn"};
+    static const char* last[] = {"Khan", "De Vries", "Janssen", "Bakker", "Visser", "Smit", "Meijer", "De Boer"};
+    static const char* street[] = {"Canal", "Harbour", "Station", "Market", "University", "Riverside"};
+
+    std::vector<std::pair<const char*, std::vector<std::string>>> sets = {
+        {"node ids", {}}, {"intersections", {}}, {"residents", {}}, {"addresses", {}}};
+    for (int i=0; i<keys; i++) {
+        sets[0].second.push_back("n" + std::to_string(i));
+        sets[1].second.push_back("Intersection " + std::to_string(i) + " & Main St");
+        sets[2].second.push_back(std::string(first[i % 10]) + " " + last[(i / 10) % 8] + " " + std::to_string(i / 80));
+        sets[3].second.push_back(std::to_string(i % 400 + 1) + " " + street[i % 6] + " Avenue, District "
+                                 + std::to_string(i / 400) + ", AlgoCity " + std::to_string(10000 + i % 9000));
+    }
+
+    for (const auto& set : sets) {
+        std::size_t bytes = 0;
+        for (const auto& k : set.second) bytes += k.size();
+        std::uint64_t sink = 0;
+        double fnvRate = mbPerSec(bytes, [&]{ for (const auto& k : set.second) sink += HashUtils::fnv1a64(k); });
+        double wordRate = mbPerSec(bytes, [&]{ for (const auto& k : set.second) sink += HashUtils::wordHash64(k); });
+        std::cout << set.first << " (avg " << bytes / set.second.size() << " bytes):\n"
+                  << "  fnv1a64    " << static_cast<long long>(fnvRate) << " MB/s";
+        printSpread(set.second, [](const std::string& k){ return HashUtils::fnv1a64(k); });
+        std::cout << "\n  wordHash64 " << static_cast<long long>(wordRate) << " MB/s";
+        printSpread(set.second, [](const std::string& k){ return HashUtils::wordHash64(k); });
+        std::cout << "\n";
+        if (sink == 42) std::cout << "\n"; // keep the loops
+    }
+    double load = static_cast<double>(keys) / static_cast<double>(HashUtils::nextPow2(keys));
+    std::cout << "(uniform hashing leaves ~" << static_cast<int>(std::exp(-load) * 1000) / 10.0
+              << "% of buckets empty at this load)\n";
+}
+
+// Total ops spread over `threads` std::threads; op(rng, i) per operation.
+template <typename Op>
+static long long timeThreads(unsigned threads, long long totalOps, Op op) {
+    return timeMs([&]{
+        std::vector<std::thread> pool;
+        for (unsigned t=0; t<threads; t++) {
+            pool.emplace_back([&, t]{
+                std::mt19937 rng(100 + t);
+                for (long long i=0; i<totalOps / threads; i++) op(rng);
+            });
+        }
+        for (auto& th : pool) th.join();
+    });
+}
+
+void concurrentLookups(int keys) {
+    if (keys < 1) { std::cout << "Need at least 1 key.\n"; return; }
+    std::vector<std::string> names;
+    for (int i=0; i<keys; i++) names.push_back("Intersection " + std::to_string(i) + " & Main St");
+
+    HashTable<int> single;
+    std::mutex globalLock;
+    ConcurrentHashTable<int> sharded;
+    for (int i=0; i<keys; i++) { single.put(names[i], i); sharded.put(names[i], i); }
+
+    const long long ops = 4000000;
+    std::vector<unsigned> counts{1};
+    for (unsigned t=2; t<=std::max(4u, Parallel::threadCount()); t*=2) counts.push_back(t);
+
+    std::cout << ops << " ops (95% get / 5% put) over " << keys << " keys; Mops/s\n"
+              << "threads   global lock   sharded (" << sharded.shardCount() << " shards)\n";
+    for (unsigned threads : counts) {
+        long long lockedMs = timeThreads(threads, ops, [&](std::mt19937& rng){
+            const std::string& k = names[rng() % keys];
+            std::lock_guard<std::mutex> lk(globalLock);
+            if (rng() % 20 == 0) single.put(k, 1);
+            else single.get(k);
+        });
+        long long shardedMs = timeThreads(threads, ops, [&](std::mt19937& rng){
+            const std::string& k = names[rng() % keys];
+            if (rng() % 20 == 0) sharded.put(k, 1);
+            else sharded.get(k);
+        });
+        auto mops = [&](long long ms) { return ms ? static_cast<double>(ops) / 1000.0 / static_cast<double>(ms) : 0.0; };
+        std::cout << threads << "         " << mops(lockedMs) << "          " << mops(shardedMs) << "\n";
+    }
+    if (Parallel::threadCount() == 1) std::cout << "(single core: more threads cannot scale here)\n";
+}
+
+void nameLookups(int keys) {
+    if (keys < 1) { std::cout << "Need at least 1 key.\n"; return; }
+    std::vector<std::string> names, missing;
+    for (int i=0; i<keys; i++) names.push_back("Intersection " + std::to_string(i) + " & Main St");
+    for (int i=0; i<keys; i++) missing.push_back("Unknown place " + std::to_string(i));
+    std::vector<std::string_view> probes(names.begin(), names.end());
+    std::shuffle(probes.begin(), probes.end(), std::mt19937(11));
+
+    HashTable<int, std::string_view> table;
+    for (int i=0; i<keys; i++) table.put(names[i], i);
+    PerfectHash mph;
+    long long buildMs = timeMs([&]{ mph.buildFrom(table); });
+
+    // what a frozen Graph does: perfect hash, then confirm against the name
+    long long sumTable = 0, sumMph = 0, falseHits = 0;
+    long long tableHit = timeMs([&]{ for (auto k : probes) sumTable += *table.get(k); });
+    long long mphHit = timeMs([&]{
+        for (auto k : probes) { int id = mph.find(k); if (id >= 0 && names[id] == k) sumMph += id; }
+    });
+    long long tableMiss = timeMs([&]{ for (const auto& k : missing) sumTable += table.contains(k); });
+    long long mphMiss = timeMs([&]{
+        for (const auto& k : missing) {
+            int id = mph.find(k);
+            falseHits += id >= 0;
+            sumMph += id >= 0 && names[id] == k;
+        }
+    });
+
+    const std::string bin = "data/bench_names.bin";
+    {
+        Graph g(false);
+        for (const auto& n : names) g.addNode(n);
+        g.saveBinary(bin);
+    }
+    GraphFile::Mapped m;
+    long long mapHit = -1;
+    long long sumMap = 0;
+    if (m.open(bin) && !m.nameIndex().empty()) {
+        mapHit = timeMs([&]{ for (auto k : probes) sumMap += m.nodeId(k); });
+    }
+    m.close();
+    std::remove(bin.c_str());
+
+    std::size_t tableBytes = table.capacity() * (32 + 1); // {hash, view, id} slot + control byte
+    std::cout << keys << " names              hit lookup   miss lookup (ms)\n"
+              << "HashTable:           " << tableHit << "   " << tableMiss << "\n"
+              << "perfect hash:        " << mphHit << "   " << mphMiss << "\n"
+              << "perfect hash (mmap): " << (mapHit < 0 ? std::string("n/a") : std::to_string(mapHit)) << "\n"
+              << "perfect hash build " << buildMs << " ms, " << mph.hashBitsPerKey() << " bits/key for the hash, "
+              << mph.bytes() * 8.0 / keys << " bits/key with fingerprints and ids\n"
+              << "HashTable ~" << tableBytes * 8.0 / keys << " bits/key (load factor " << table.loadFactor() << ")\n"
+              << "fingerprint false hits on " << keys << " absent names: " << falseHits << "\n";
+    if (sumTable != sumMph || (mapHit >= 0 && sumMap != sumMph)) std::cout << "WARNING: results differ.\n";
+}
+
+// Log-shaped text: timestamps, event kinds, place names, numbers.
+static std::string cityLog(std::size_t bytes, unsigned seed) {
+    static const char* kinds[] = {"route", "dispatch", "closure", "reopen", "census"};
+    static const char* places[] = {"CityHall", "Airport", "Hospital", "GrandHotel", "Harbour", "Station", "Market"};
+    std::mt19937 rng(seed);
+    std::string out;
+    out.reserve(bytes + 128);
+    long long t = 0;
+    while (out.size() < bytes) {
+        t += rng() % 5000;
+        out += "2026-10-19 " + std::to_string(t / 1000) + "." + std::to_string(t % 1000) + " ";
+        out += kinds[rng() % 5];
+        out += " ";
+        out += places[rng() % 7];
+        out += " -> ";
+        out += places[rng() % 7];
+        out += " " + std::to_string(rng() % 120) + " min\n";
+    }
+    out.resize(bytes);
+    return out;
+}
+
+void huffman(int megabytes) {
+    if (megabytes < 1) { std::cout << "Need at least 1 MB.\n"; return; }
+    const std::string text = cityLog(static_cast<std::size_t>(megabytes) << 20, 5);
+    HuffmanBlob blob;
+    std::string back;
+    long long encMs = timeMs([&]{ blob = Huffman::compress(text); });
+    long long decMs = timeMs([&]{ back = Huffman::decompress(blob); });
+
+    // same data through the block stream, file to file
+    const std::string raw = "data/bench_log.txt", packed = "data/bench_log.achs", unpacked = "data/bench_log.out";
+    { std::ofstream(raw, std::ios::binary) << text; }
+    bool streamOk = true;
+    long long streamEncMs = timeMs([&]{ streamOk = FileIO::compressFile(raw, packed) && streamOk; });
+    long long streamDecMs = timeMs([&]{ streamOk = FileIO::decompressFile(packed, unpacked) && streamOk; });
+    std::string streamed;
+    {
+        std::ifstream f(unpacked, std::ios::binary);
+        streamed.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    std::remove(raw.c_str());
+    std::remove(packed.c_str());
+    std::remove(unpacked.c_str());
+
+    double mb = static_cast<double>(megabytes);
+    std::cout << "Input " << megabytes << " MB, compressed " << blob.data.size() * 100 / text.size() << "%\n"
+              << "compress:   " << encMs << " ms (" << (encMs ? mb * 1000 / encMs : 0) << " MB/s)\n"
+              << "decompress: " << decMs << " ms (" << (decMs ? mb * 1000 / decMs : 0) << " MB/s)\n"
+              << "streamed in " << (FileIO::kBlockSize >> 20) << " MB blocks on " << Parallel::threadCount()
+              << " threads, file to file:\n"
+              << "compress:   " << streamEncMs << " ms (" << (streamEncMs ? mb * 1000 / streamEncMs : 0) << " MB/s)\n"
+              << "decompress: " << streamDecMs << " ms (" << (streamDecMs ? mb * 1000 / streamDecMs : 0) << " MB/s)\n";
+    if (back != text || !streamOk || streamed != text) std::cout << "WARNING: round trip differs.\n";
+}
+
+void routingCluster(int nodes) {
+    if (nodes < 100) { std::cout << "Need at least 100 nodes.\n"; return; }
+    Graph g(false);
+    buildRoadNetwork(g, nodes, 42);
+    RoutingCluster cluster;
+    if (!cluster.start(g, 4)) { std::cout << "Could not start routing cluster.\n"; return; }
+
+    std::mt19937 rng(13);
+    std::vector<std::pair<int,int>> trips;
+    for (int i=0; i<200; i++) trips.push_back({static_cast<int>(rng() % nodes), static_cast<int>(rng() % nodes)});
+
+    std::vector<Algorithms::PathResult> viaCluster, direct;
+    long long clusterMs = timeMs([&]{ for (auto t : trips) viaCluster.push_back(cluster.route(t.first, t.second)); });
+    long long directMs = timeMs([&]{ for (auto t : trips) direct.push_back(Algorithms::dijkstra(g, t.first, t.second)); });
+    int mismatches = 0;
+    for (std::size_t i=0; i<trips.size(); i++) {
+        const auto& a = viaCluster[i];
+        const auto& b = direct[i];
+        if (a.reachable != b.reachable || (a.reachable && a.distance != b.distance)) mismatches++;
+    }
+    std::cout << trips.size() << " queries on " << g.V() << " nodes, " << cluster.parts() << " regions ("
+              << cluster.cutEdges() << " cut edges, " << cluster.overlayNodes() << " boundary nodes):\n"
+              << "Routing cluster: " << clusterMs << " ms\n"
+              << "Direct Dijkstra: " << directMs << " ms\n"
+              << "Distance mismatches: " << mismatches << "\n";
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Timing comparisons on synthetic data, printed to stdout.
+namespace Benchmarks {
+    // Prim vs Kruskal vs Boruvka on a sparse random road network.
+    void mstEngines(int nodes);
+
+    // Text road file vs binary snapshot vs bare mmap open (temp files in data/).
+    void graphLoading(int nodes);
+
+    // Dijkstra/BFS time, id locality and (where perf events are available)
+    // cache misses on shuffled ids vs after RCM renumbering.
+    void nodeOrdering(int nodes);
+
+    // Many short Dijkstra queries: fresh scratch arrays per query vs a
+    // reused generation-stamped SearchWorkspace.
+    void shortQueries(int nodes);
+
+    // GPS snapping throughput of the k-d tree (nodes located at random).
+    void pointSnapping(int nodes);
+
+    // Layered random job DAG on the work-stealing executor: one thread vs
+    // the whole pool, with critical path and achieved parallelism.
+    void dagExecutor(int tasks);
+
+    // HashTable (open addressing) vs std::unordered_map on location-style
+    // string keys: inserts (plus the slowest single insert), successful
+    // and failed lookups.
+    void hashTables(int keys);
+
+    // fnv1a64 vs wordHash64: throughput and low-bit bucket spread on key
+    // sets shaped like ours (node ids, intersections, residents, addresses).
+    void hashFunctions(int keys);
+
+    // 95% lookups / 5% writes from 1..N threads: one HashTable behind a
+    // global mutex vs the sharded ConcurrentHashTable.
+    void concurrentLookups(int keys);
+
+    // Frozen name -> id map: HashTable vs the minimal perfect hash (in
+    // memory and straight from a mapped graph file), plus bits per key.
+    void nameLookups(int keys);
+
+    // Huffman compress / decompress throughput on synthetic city logs,
+    // whole buffer in memory and through FileIO's block stream (parallel
+    // over blocks; ALGOCITY_THREADS sets the thread count).
+    void huffman(int megabytes);
+
+    // Random trips through a 4-region RoutingCluster vs a direct Dijkstra
+    // on the whole graph: time, and any distance that disagrees.
+    void routingCluster(int nodes);
+}
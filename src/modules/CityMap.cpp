@@ -3,6 +3,7 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 
 CityMap::CityMap() : roads_(false) {}
 
@@ -14,37 +15,156 @@ void CityMap::loadRoads(const std::string& path) {
     }
     std::string line;
     int edges = 0;
+    int located = 0;
     while (std::getline(f, line)) {
         if (line.empty()) continue;
+        if (line[0] == '@') {
+            std::stringstream ss(line.substr(1));
+            std::string name, sx, sy;
+            if (!std::getline(ss,name,';')) continue;
+            if (!std::getline(ss,sx,';')) continue;
+            if (!std::getline(ss,sy,';')) continue;
+            setLocationCoord(name, std::stod(sx), std::stod(sy));
+            located++;
+            continue;
+        }
         std::stringstream ss(line);
         std::string a,b,sw;
         if (!std::getline(ss,a,';')) continue;
         if (!std::getline(ss,b,';')) continue;
         if (!std::getline(ss,sw,';')) continue;
-        addRoad(a,b,std::stoi(sw));
-        edges++;
+        if (addRoad(a,b,std::stoi(sw))) edges++;
     }
-    std::cout << "Loaded roads: " << edges << " edges, " << roads_.V() << " nodes.\n";
+    roads_.freezeNames(); // the intersections are known now; lookups dominate
+    std::cout << "Loaded roads: " << edges << " edges, " << roads_.V() << " nodes";
+    if (located) std::cout << ", " << located << " located";
+    std::cout << ".\n";
 }
 
-void CityMap::addRoad(const std::string& a, const std::string& b, int w) {
+void CityMap::saveRoadsBinary(const std::string& path) const {
+    if (!roads_.saveBinary(path)) { std::cout << "Failed to write: " << path << "\n"; return; }
+    std::cout << "Saved " << roads_.V() << " nodes to " << path << "\n";
+}
+
+void CityMap::loadRoadsBinary(const std::string& path) {
+    if (!roads_.loadBinary(path)) { // the current map stays loaded
+        std::cout << "Failed to load binary map: " << path << "\n";
+        return;
+    }
+    cluster_.stop();
+    routeCache_.clear();
+    hotSources_.clear();
+    spatialDirty_ = true;
+    std::cout << "Loaded binary map: " << roads_.V() << " nodes.\n";
+}
+
+void CityMap::optimizeLayout() {
+    auto newId = Algorithms::hilbertOrder(roads_);
+    if (newId.empty()) newId = Algorithms::rcmOrder(roads_);
+    roads_.renumber(newId);
+    cluster_.stop();
+    routeCache_.clear();
+    spatialDirty_ = true;
+
+    std::vector<int> sources;
+    for (const auto& t : hotSources_) sources.push_back(newId[t.source()]);
+    hotSources_.clear();
+    for (int s : sources) hotSources_.emplace_back(roads_, s);
+}
+
+bool CityMap::addRoad(const std::string& a, const std::string& b, int w) {
+    if (w < 0) return false; // Dijkstra and the tracked trees assume w >= 0
     roads_.addEdge(a,b,w);
+    roadsChanged(roads_.nodeId(a), roads_.nodeId(b));
+    return true;
+}
+
+bool CityMap::closeRoad(const std::string& a, const std::string& b) {
+    auto ia = roads_.nodeIdOpt(a);
+    auto ib = roads_.nodeIdOpt(b);
+    if (!ia || !ib || !roads_.removeEdge(*ia, *ib)) return false;
+    roadsChanged(*ia, *ib);
+    return true;
+}
+
+bool CityMap::setRoadLength(const std::string& a, const std::string& b, int w) {
+    if (w < 0) return false;
+    auto ia = roads_.nodeIdOpt(a);
+    auto ib = roads_.nodeIdOpt(b);
+    if (!ia || !ib || !roads_.updateWeight(*ia, *ib, w)) return false;
+    roadsChanged(*ia, *ib);
+    return true;
+}
+
+bool CityMap::trackSource(const std::string& start) {
+    auto s = roads_.nodeIdOpt(start);
+    if (!s) return false;
+    for (const auto& t : hotSources_) if (t.source() == *s) return true;
+    hotSources_.emplace_back(roads_, *s);
+    return true;
+}
+
+void CityMap::roadsChanged(int u, int v) {
+    cluster_.stop();
+    routeCache_.clear();
+    for (auto& t : hotSources_) t.edgeChanged(u, v);
 }
 
 void CityMap::bfsFrom(const std::string& start) const {
     auto sid = roads_.nodeIdOpt(start);
     if (!sid) { std::cout << "Unknown location.\n"; return; }
-    auto order = Algorithms::bfs(roads_, *sid);
+    auto hops = Algorithms::bfsLevels(roads_, *sid);
+
+    // bucket by hop count so the listing reads level by level
+    int maxHop = 0;
+    for (int h : hops) if (h > maxHop) maxHop = h;
+    std::vector<std::vector<int>> byHop(maxHop + 1);
+    for (int v=0; v<roads_.V(); v++) if (hops[v] >= 0) byHop[hops[v]].push_back(v);
+
     std::cout << "BFS order from " << start << ":\n";
-    for (int id : order) std::cout << " - " << roads_.nodeName(id) << "\n";
+    for (int h=0; h<=maxHop; h++) {
+        for (int id : byHop[h]) std::cout << " - " << roads_.nodeName(id) << " (hops=" << h << ")\n";
+    }
+}
+
+bool CityMap::reachable(const std::string& a, const std::string& b) const {
+    auto ia = roads_.nodeIdOpt(a);
+    auto ib = roads_.nodeIdOpt(b);
+    if (!ia || !ib) return false;
+    return Algorithms::bfsLevels(roads_, *ia)[*ib] >= 0;
 }
 
 void CityMap::shortestPath(const std::string& a, const std::string& b) const {
+    if (!roads_.nodeIdOpt(a) || !roads_.nodeIdOpt(b)) { std::cout << "Unknown location(s).\n"; return; }
+
+    auto res = route(a, b);
+    if (!res.reachable) {
+        std::cout << "No route found.\n";
+        return;
+    }
+    std::cout << "Shortest distance: " << res.distance << "\nPath:\n";
+    for (std::size_t i=0;i<res.path.size();i++) {
+        std::cout << roads_.nodeName(res.path[i]);
+        if (i+1<res.path.size()) std::cout << " -> ";
+    }
+    std::cout << "\n";
+}
+
+bool CityMap::startRoutingCluster(int parts) {
+    cluster_.stop();
+    if (!cluster_.start(roads_, parts)) return false;
+    std::cout << "Routing cluster: " << cluster_.parts() << " workers, " << cluster_.cutEdges()
+              << " cut roads, " << cluster_.overlayNodes() << " boundary locations.\n";
+    return true;
+}
+
+void CityMap::clusterShortestPath(const std::string& a, const std::string& b) {
     auto ia = roads_.nodeIdOpt(a);
     auto ib = roads_.nodeIdOpt(b);
     if (!ia || !ib) { std::cout << "Unknown location(s).\n"; return; }
+    if (!cluster_.running()) { std::cout << "Routing cluster is not running.\n"; return; }
 
-    auto res = Algorithms::dijkstra(roads_, *ia, *ib);
+    auto res = cluster_.route(*ia, *ib);
     if (!res.reachable) {
         std::cout << "No route found.\n";
         return;
@@ -57,12 +177,50 @@ void CityMap::shortestPath(const std::string& a, const std::string& b) const {
     std::cout << "\n";
 }
 
-void CityMap::optimizePowerGrid(const std::string& start) const {
-    auto s = roads_.nodeIdOpt(start);
-    if (!s) { std::cout << "Unknown start location.\n"; return; }
+Algorithms::PathResult CityMap::route(const std::string& a, const std::string& b) const {
+    auto ia = roads_.nodeIdOpt(a);
+    auto ib = roads_.nodeIdOpt(b);
+    if (!ia || !ib) return {};
 
-    auto mst = Algorithms::primMST(roads_, *s);
-    std::cout << "MST total cost (wire length): " << mst.totalCost << "\nEdges:\n";
+    for (const auto& t : hotSources_) {
+        if (t.source() != *ia) continue;
+        Algorithms::PathResult res;
+        res.path = t.pathTo(*ib);
+        res.reachable = !res.path.empty();
+        if (res.reachable) res.distance = t.distance(*ib);
+        return res;
+    }
+
+    std::uint64_t key = (static_cast<std::uint64_t>(*ia) << 32) | static_cast<std::uint32_t>(*ib);
+    if (auto hit = routeCache_.get(key)) return *hit;
+
+    auto res = Algorithms::dijkstra(roads_, *ia, *ib);
+    routeCache_.put(key, res);
+    return res;
+}
+
+void CityMap::printRouteCacheStats() const {
+    std::cout << "Route cache: " << routeCache_.size() << "/" << routeCache_.capacity() << " entries"
+              << ", hits=" << routeCache_.hits()
+              << ", misses=" << routeCache_.misses()
+              << ", evictions=" << routeCache_.evictions() << "\n";
+}
+
+void CityMap::optimizePowerGrid(const std::string& start, GridEngine engine) const {
+    Algorithms::MSTResult mst;
+    if (engine == GridEngine::Prim) {
+        auto s = roads_.nodeIdOpt(start);
+        if (!s) { std::cout << "Unknown start location.\n"; return; }
+        mst = Algorithms::primMST(roads_, *s);
+    } else if (engine == GridEngine::Kruskal) {
+        mst = Algorithms::kruskalMST(roads_);
+    } else {
+        mst = Algorithms::boruvkaMST(roads_);
+    }
+
+    std::cout << "MST total cost (wire length): " << mst.totalCost;
+    if (mst.components > 1) std::cout << " across " << mst.components << " separate grids";
+    std::cout << "\nEdges:\n";
     for (int v=0; v<roads_.V(); v++) {
         int p = mst.parent[v];
         if (p == -1) continue;
@@ -70,3 +228,90 @@ void CityMap::optimizePowerGrid(const std::string& start) const {
     }
 }
 
+std::vector<std::pair<std::string,int>> CityMap::isochrone(const std::string& start, int budget) const {
+    std::vector<std::pair<std::string,int>> out;
+    auto s = roads_.nodeIdOpt(start);
+    if (!s) return out;
+    for (auto r : Algorithms::withinDistance(roads_, *s, budget)) out.emplace_back(roads_.nodeName(r.node), r.dist);
+    return out;
+}
+
+std::vector<std::pair<std::string,int>> CityMap::nearestFacilities(const std::string& start,
+                                                                   const std::vector<std::string>& facilities,
+                                                                   int k) const {
+    std::vector<std::pair<std::string,int>> out;
+    auto s = roads_.nodeIdOpt(start);
+    if (!s) return out;
+
+    std::vector<int> ids; // sorted, for O(log F) membership tests
+    for (const auto& f : facilities) {
+        if (auto id = roads_.nodeIdOpt(f)) ids.push_back(*id);
+    }
+    std::sort(ids.begin(), ids.end());
+    auto isFacility = [&](int v) { return std::binary_search(ids.begin(), ids.end(), v); };
+
+    for (auto r : Algorithms::nearestK(roads_, *s, k, isFacility)) out.emplace_back(roads_.nodeName(r.node), r.dist);
+    return out;
+}
+
+void CityMap::setLocationCoord(const std::string& name, double x, double y) {
+    roads_.setCoord(roads_.addNode(name), x, y);
+    spatialDirty_ = true;
+}
+
+const KDTree& CityMap::spatialIndex() const {
+    if (spatialDirty_) {
+        std::vector<KDTree::Point> pts;
+        for (int v=0; v<roads_.V(); v++) {
+            if (roads_.hasCoord(v)) pts.push_back({roads_.coordX(v), roads_.coordY(v), v});
+        }
+        spatial_.build(std::move(pts));
+        spatialDirty_ = false;
+    }
+    return spatial_;
+}
+
+std::optional<std::string> CityMap::nearestLocation(double x, double y) const {
+    int id = spatialIndex().nearest(x, y);
+    if (id < 0) return std::nullopt;
+    return std::string(roads_.nodeName(id));
+}
+
+std::vector<std::string> CityMap::locationsInBox(double minX, double minY, double maxX, double maxY) const {
+    std::vector<std::string> out;
+    for (int id : spatialIndex().withinBox(minX, minY, maxX, maxY)) out.emplace_back(roads_.nodeName(id));
+    return out;
+}
+
+std::vector<int> CityMap::snapPoints(const std::vector<KDTree::Point>& points) const {
+    return spatialIndex().nearestBatch(points);
+}
+
+Algorithms::DistanceMatrix CityMap::distanceMatrix(const std::vector<std::string>& sources,
+                                                   const std::vector<std::string>& targets) const {
+    std::vector<int> src, dst;
+    src.reserve(sources.size());
+    dst.reserve(targets.size());
+    for (const auto& s : sources) src.push_back(roads_.nodeId(s));
+    for (const auto& t : targets) dst.push_back(roads_.nodeId(t));
+    return Algorithms::distanceMatrix(roads_, src, dst);
+}
+
+void CityMap::printDistanceTable(const std::vector<std::string>& sources,
+                                 const std::vector<std::string>& targets) const {
+    for (const auto* names : {&sources, &targets}) {
+        for (const auto& n : *names) {
+            if (!roads_.nodeIdOpt(n)) { std::cout << "Unknown location: " << n << "\n"; return; }
+        }
+    }
+    auto m = distanceMatrix(sources, targets);
+    for (int r=0; r<m.rows; r++) {
+        std::cout << sources[r] << ":";
+        for (int c=0; c<m.cols; c++) {
+            std::cout << " " << targets[c] << "=";
+            if (m.at(r, c) < 0) std::cout << "-";
+            else std::cout << m.at(r, c);
+        }
+        std::cout << "\n";
+    }
+}
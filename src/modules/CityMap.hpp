@@ -1,21 +1,103 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <utility>
 #include "structures/graph/Graph.hpp"
+#include "structures/graph/Algorithms.hpp"
+#include "structures/graph/DynamicSSSP.hpp"
+#include "structures/hash/LRUCache.hpp"
+#include "structures/tree/KDTree.hpp"
+#include "modules/RoutingCluster.hpp"
+#include <optional>
 
 class CityMap {
 public:
+    enum class GridEngine { Prim, Kruskal, Boruvka };
+
     CityMap();
 
+    // Road file lines are "From;To;Distance". Lines "@Name;x;y" give a
+    // location's coordinates (optional, used by the spatial queries).
     void loadRoads(const std::string& path);
 
-    void addRoad(const std::string& a, const std::string& b, int w);
+    // Binary snapshot of the road graph (see GraphFile.hpp). Loading maps
+    // the file and routes straight off it (see Graph::loadBinary) until the
+    // first road edit; it replaces the current map and drops cached routes /
+    // tracked origins.
+    void saveRoadsBinary(const std::string& path) const;
+    void loadRoadsBinary(const std::string& path);
+
+    // Renumber intersections so neighbours get nearby ids (Hilbert curve
+    // when every location has coordinates, RCM otherwise); names and
+    // tracked origins follow, cached routes are dropped.
+    void optimizeLayout();
+
+    // Lengths must be >= 0: addRoad/setRoadLength return false (map
+    // unchanged) for a negative w.
+    bool addRoad(const std::string& a, const std::string& b, int w);
+    bool closeRoad(const std::string& a, const std::string& b);                // false if no such road
+    bool setRoadLength(const std::string& a, const std::string& b, int w);     // false if no such road
+
+    // Keep a live shortest-path tree for a frequently used origin; road
+    // updates repair it incrementally and route() answers from it.
+    bool trackSource(const std::string& start);
     void bfsFrom(const std::string& start) const;
+    bool reachable(const std::string& a, const std::string& b) const;
     void shortestPath(const std::string& a, const std::string& b) const;
-    void optimizePowerGrid(const std::string& start) const;
+
+    // Shortest route between two locations, served from the route cache when
+    // possible (unknown names give an unreachable result).
+    Algorithms::PathResult route(const std::string& a, const std::string& b) const;
+    void printRouteCacheStats() const;
+    // Prim wires start's district only; Kruskal/Boruvka wire every
+    // district (minimum spanning forest) and ignore start.
+    void optimizePowerGrid(const std::string& start, GridEngine engine = GridEngine::Prim) const;
+
+    // Locations reachable within `budget` road distance of start, nearest first.
+    std::vector<std::pair<std::string,int>> isochrone(const std::string& start, int budget) const;
+    // The k facilities (e.g. every hospital) closest to start by road, nearest first.
+    std::vector<std::pair<std::string,int>> nearestFacilities(const std::string& start,
+                                                              const std::vector<std::string>& facilities,
+                                                              int k) const;
+
+    // Coordinate lookups over a k-d tree of the located intersections.
+    void setLocationCoord(const std::string& name, double x, double y);
+    std::optional<std::string> nearestLocation(double x, double y) const;
+    std::vector<std::string> locationsInBox(double minX, double minY, double maxX, double maxY) const;
+    // Node ids in graph() for each point (-1 if nothing is located); parallel.
+    std::vector<int> snapPoints(const std::vector<KDTree::Point>& points) const;
+
+    // Road distance from every source to every target (-1 = no route).
+    // Throws std::out_of_range for unknown location names.
+    Algorithms::DistanceMatrix distanceMatrix(const std::vector<std::string>& sources,
+                                              const std::vector<std::string>& targets) const;
+    void printDistanceTable(const std::vector<std::string>& sources,
+                            const std::vector<std::string>& targets) const;
+
+    // Split the map into `parts` regions served by worker processes
+    // (RoutingCluster); any road change or reload shuts the cluster down.
+    bool startRoutingCluster(int parts);
+    void stopRoutingCluster() { cluster_.stop(); }
+    // Same as shortestPath(), answered by the cluster (Benchmarks::routingCluster
+    // cross-checks it against a direct search).
+    void clusterShortestPath(const std::string& a, const std::string& b);
 
     const Graph& graph() const { return roads_; }
 
 private:
     Graph roads_; // undirected weighted
+
+    // (src,dst) -> PathResult; cleared whenever the road graph changes
+    mutable LRUCache<Algorithms::PathResult> routeCache_{1024};
+    std::vector<DynamicSSSP> hotSources_;
+
+    // built on first spatial query after the located set / ids change
+    mutable KDTree spatial_;
+    mutable bool spatialDirty_{true};
+    const KDTree& spatialIndex() const;
+
+    RoutingCluster cluster_;
+
+    void roadsChanged(int u, int v);
 };
 
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <optional>
+#include "structures/graph/Graph.hpp"
+#include "structures/graph/TopoSort.hpp"
+
+// Construction tasks and their prerequisites. The build order is kept
+// current as dependencies are added; one that would make a circular
+// dependency is refused on the spot.
+class ConstructionPlanner {
+public:
+    ConstructionPlanner() : tasks_(true) { order_.emplace(tasks_); }
+
+    // Lines are "Prerequisite;Task". Replaces whatever was planned before.
+    void loadTasks(const std::string& path);
+    // false (and the cycle is printed) if task already leads to pre.
+    bool addDependency(const std::string& pre, const std::string& task);
+    void printOrder() const;
+    // Runs every task on the DAG executor (a short sleep stands in for the
+    // work) and prints its timeline, the critical path and the parallelism.
+    void simulate() const;
+
+    const Graph& tasks() const { return tasks_; }
+
+private:
+    Graph tasks_;
+    std::optional<TopoSort::Online> order_; // refers to tasks_, rebuilt with it
+};
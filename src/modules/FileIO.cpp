@@ -1,5 +1,13 @@
 #include "modules/FileIO.hpp"
+#include "Parallel.hpp"
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
 
 bool FileIO::saveCompressedText(const std::string& path, const std::string& text) {
     HuffmanBlob blob = Huffman::compress(text);
@@ -15,3 +23,232 @@ std::string FileIO::loadCompressedText(const std::string& path) {
     return Huffman::decompress(*blob);
 }
 
+static const char kStreamMagic[4] = {'A','C','H','S'};
+static const int kStreamVersion = 2;
+static const char kIndexMagic[8] = {'A','C','H','S','I','D','X','\0'};
+
+struct IndexFooter {
+    std::uint64_t total;     // uncompressed bytes
+    std::uint64_t offsetsAt; // u64 offset per block starts here
+    std::uint64_t blocks;
+    char magic[8];
+};
+
+// Blocks in flight per batch: a couple per thread evens out uneven blocks.
+static std::size_t batchBlocks() { return static_cast<std::size_t>(Parallel::threadCount()) * 2; }
+
+static bool readStreamHeader(std::istream& in, int& version, std::uint64_t& blockSize) {
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kStreamMagic, sizeof(magic)) != 0) return false;
+    version = in.get();
+    if (version != 1 && version != kStreamVersion) return false;
+    return Huffman::readVarint(in, blockSize) && blockSize > 0;
+}
+
+// End of the block list at the current position: 0 tag, then the total,
+// ending exactly where the offset table starts.
+static bool readTail(std::istream& in, std::uint64_t total, std::uint64_t offsetsAt) {
+    std::uint64_t stored = 0;
+    return in.get() == 0 && Huffman::readVarint(in, stored) && stored == total
+        && static_cast<std::uint64_t>(in.tellg()) == offsetsAt;
+}
+
+// One archived block at the current position: tag, then the blob.
+static bool decodeBlock(std::istream& in, std::uint64_t blockSize, std::string& text) {
+    if (in.get() != 1) return false;
+    auto blob = Huffman::read(in);
+    if (!blob || blob->symbols == 0 || blob->symbols > blockSize) return false;
+    text = Huffman::decompress(*blob);
+    return text.size() == blob->symbols;
+}
+
+bool FileIO::compressStream(std::istream& in, std::ostream& out, std::size_t blockSize) {
+    if (blockSize == 0) return false;
+    std::ostringstream head;
+    head.write(kStreamMagic, sizeof(kStreamMagic));
+    head.put(static_cast<char>(kStreamVersion));
+    Huffman::writeVarint(head, blockSize);
+    out << head.str();
+    std::uint64_t at = head.str().size();
+
+    const std::size_t batch = batchBlocks();
+    std::vector<std::string> raw(batch), packed(batch);
+    std::vector<char> ok(batch);
+    std::vector<std::uint64_t> offsets;
+    std::uint64_t total = 0;
+    bool more = true;
+    while (more) {
+        std::size_t count = 0;
+        while (count < batch && more) {
+            raw[count].resize(blockSize);
+            in.read(&raw[count][0], static_cast<std::streamsize>(blockSize));
+            std::size_t got = static_cast<std::size_t>(in.gcount());
+            raw[count].resize(got);
+            more = got == blockSize;
+            if (got) count++;
+        }
+        if (in.bad()) return false;
+
+        Parallel::forRange(count, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i=b; i<e; i++) {
+                std::ostringstream blob;
+                ok[i] = Huffman::write(blob, Huffman::compress(raw[i]));
+                packed[i] = blob.str();
+            }
+        });
+        for (std::size_t i=0; i<count; i++) {
+            if (!ok[i]) return false;
+            offsets.push_back(at);
+            out.put(1);
+            out.write(packed[i].data(), static_cast<std::streamsize>(packed[i].size()));
+            at += 1 + packed[i].size();
+            total += raw[i].size();
+        }
+        if (!out) return false;
+    }
+
+    std::ostringstream tail;
+    tail.put(0);
+    Huffman::writeVarint(tail, total);
+    out << tail.str();
+    at += tail.str().size();
+    out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * 8));
+    IndexFooter foot{total, at, offsets.size(), {}};
+    std::memcpy(foot.magic, kIndexMagic, sizeof(kIndexMagic));
+    out.write(reinterpret_cast<const char*>(&foot), sizeof(foot));
+    return static_cast<bool>(out);
+}
+
+bool FileIO::decompressStream(std::istream& in, std::ostream& out) {
+    int version = 0;
+    std::uint64_t blockSize = 0;
+    if (!readStreamHeader(in, version, blockSize)) return false;
+
+    // parse a batch in order, decode it in parallel, write it in order
+    const std::size_t batch = batchBlocks();
+    std::vector<HuffmanBlob> blobs(batch);
+    std::vector<std::string> texts(batch);
+    std::uint64_t total = 0;
+    bool end = false;
+    while (!end) {
+        std::size_t count = 0;
+        while (count < batch) {
+            int tag = in.get();
+            if (tag == 0) { end = true; break; }
+            if (tag != 1) return false; // truncated or corrupt
+            auto blob = Huffman::read(in);
+            if (!blob || blob->symbols == 0 || blob->symbols > blockSize) return false;
+            blobs[count++] = std::move(*blob);
+        }
+        Parallel::forRange(count, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i=b; i<e; i++) texts[i] = Huffman::decompress(blobs[i]);
+        });
+        for (std::size_t i=0; i<count; i++) {
+            if (texts[i].size() != blobs[i].symbols) return false;
+            out.write(texts[i].data(), static_cast<std::streamsize>(texts[i].size()));
+            total += texts[i].size();
+        }
+        if (!out) return false;
+    }
+    std::uint64_t expected = 0;
+    return Huffman::readVarint(in, expected) && expected == total;
+}
+
+// Runs fn(in, out) from `from` into a temporary next to `to`, renamed
+// over `to` only on success: a missing or malformed source never touches
+// an existing destination, and a file is never written onto itself.
+template <class Fn>
+static bool convertFile(const std::string& from, const std::string& to, std::ios::openmode mode, Fn fn) {
+    std::ifstream in(from, std::ios::binary | mode);
+    if (!in) return false;
+    std::error_code ec;
+    if (from == to || std::filesystem::equivalent(from, to, ec)) return false;
+    const std::string tmp = to + ".tmp";
+    bool ok;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        ok = out && fn(in, out);
+        out.close();
+        ok = ok && !out.fail();
+    }
+    if (ok) std::filesystem::rename(tmp, to, ec);
+    if (!ok || ec) { std::remove(tmp.c_str()); return false; }
+    return true;
+}
+
+// `in` is opened at the end (to find the footer); `from` reopens the
+// archive once per worker.
+static bool decompressIndexed(const std::string& from, std::ifstream& in, std::ostream& out) {
+    // offset table present? (version 2, written by compressStream)
+    const std::uint64_t size = static_cast<std::uint64_t>(in.tellg());
+    IndexFooter foot{};
+    bool indexed = size >= sizeof(foot)
+        && in.seekg(static_cast<std::streamoff>(size - sizeof(foot)))
+        && in.read(reinterpret_cast<char*>(&foot), sizeof(foot))
+        && std::memcmp(foot.magic, kIndexMagic, sizeof(kIndexMagic)) == 0
+        && foot.blocks <= size / 8 && foot.offsetsAt + foot.blocks * 8 + sizeof(foot) == size;
+    in.clear();
+    in.seekg(0);
+    if (!indexed) return FileIO::decompressStream(in, out);
+
+    int version = 0;
+    std::uint64_t blockSize = 0;
+    if (!readStreamHeader(in, version, blockSize)) return false;
+    const std::uint64_t headerEnd = static_cast<std::uint64_t>(in.tellg());
+    std::vector<std::uint64_t> offsets(static_cast<std::size_t>(foot.blocks));
+    in.seekg(static_cast<std::streamoff>(foot.offsetsAt));
+    if (!offsets.empty() && !in.read(reinterpret_cast<char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * 8)))
+        return false;
+    // blocks are back to back: first right after the header, strictly
+    // increasing, each ending where the next begins (checked while decoding)
+    for (std::size_t i=0; i<offsets.size(); i++) {
+        std::uint64_t prev = i ? offsets[i - 1] : headerEnd - 1;
+        if (offsets[i] <= prev || offsets[i] >= foot.offsetsAt) return false;
+    }
+    if (!offsets.empty() && offsets[0] != headerEnd) return false;
+    if (offsets.empty()) {
+        in.seekg(static_cast<std::streamoff>(headerEnd));
+        return readTail(in, foot.total, foot.offsetsAt);
+    }
+
+    // every worker reads its own blocks through its own file handle
+    const std::size_t batch = batchBlocks();
+    std::vector<std::string> texts(batch);
+    std::vector<char> ok(batch);
+    std::uint64_t total = 0;
+    for (std::size_t first=0; first<offsets.size(); first+=batch) {
+        std::size_t count = std::min(batch, offsets.size() - first);
+        Parallel::forRange(count, 1, [&](std::size_t b, std::size_t e) {
+            std::ifstream f(from, std::ios::binary);
+            for (std::size_t i=b; i<e; i++) {
+                const std::size_t k = first + i;
+                f.seekg(static_cast<std::streamoff>(offsets[k]));
+                ok[i] = f && decodeBlock(f, blockSize, texts[i]);
+                if (!ok[i]) continue;
+                if (k + 1 < offsets.size()) ok[i] = static_cast<std::uint64_t>(f.tellg()) == offsets[k + 1];
+                else ok[i] = readTail(f, foot.total, foot.offsetsAt); // the last block ends at the 0 tag
+            }
+        });
+        for (std::size_t i=0; i<count; i++) {
+            // all blocks but the last are full
+            bool last = first + i + 1 == offsets.size();
+            if (!ok[i] || (!last && texts[i].size() != blockSize)) return false;
+            out.write(texts[i].data(), static_cast<std::streamsize>(texts[i].size()));
+            total += texts[i].size();
+        }
+        if (!out) return false;
+    }
+    return total == foot.total;
+}
+
+bool FileIO::compressFile(const std::string& from, const std::string& to) {
+    return convertFile(from, to, std::ios::in, [](std::ifstream& in, std::ofstream& out) {
+        return compressStream(in, out);
+    });
+}
+
+bool FileIO::decompressFile(const std::string& from, const std::string& to) {
+    return convertFile(from, to, std::ios::ate, [&](std::ifstream& in, std::ofstream& out) {
+        return decompressIndexed(from, in, out);
+    });
+}
@@ -1,11 +1,36 @@
 #pragma once
 #include <string>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
 #include "structures/tree/Huffman.hpp"
 
-// Demonstrates Huffman compression when saving a "city state" text blob.
+// Demonstrates Huffman compression when saving a "city state" text blob,
+// and archives files of any size as a stream of independently coded
+// blocks (each with its own code table). Blocks are coded and decoded a
+// batch at a time on the Parallel pool; memory use stays at about one
+// batch (a few blocks per thread) on both sides.
 class FileIO {
 public:
+    static const std::size_t kBlockSize = std::size_t(1) << 20;
+
     static bool saveCompressedText(const std::string& path, const std::string& text);
     static std::string loadCompressedText(const std::string& path);
-};
 
+    // Stream format: "ACHS" | u8 version | varint block size |
+    //   { u8 1 | Huffman blob }* | u8 0 | varint total bytes |
+    //   block offsets u64[blocks] | u64 total | u64 offsets at | u64 blocks | "ACHSIDX\0"
+    // Offsets count from the start of the archive. Version 1 archives end
+    // after the total and have no offset table.
+    // false on I/O errors or malformed input (out may hold a prefix).
+    static bool compressStream(std::istream& in, std::ostream& out, std::size_t blockSize = kBlockSize);
+    static bool decompressStream(std::istream& in, std::ostream& out);
+
+    // decompressFile uses the offset table: each worker seeks to and reads
+    // its own blocks, so parsing and I/O run in parallel as well.
+    // Both write through "<to>.tmp" and leave `to` untouched on failure;
+    // from and to must be different files.
+    static bool compressFile(const std::string& from, const std::string& to);
+    static bool decompressFile(const std::string& from, const std::string& to);
+};
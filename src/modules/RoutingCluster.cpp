@@ -0,0 +1,276 @@
+#include "modules/RoutingCluster.hpp"
+#include "structures/graph/Partitioner.hpp"
+#include "structures/graph/SearchWorkspace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Wire format, both directions: [u32 count][count x i32].
+// Requests: {kTable, nFrom, nTo, from..., to...} -> nFrom*nTo distances (-1 = none)
+//           {kPath, a, b}                       -> local ids a..b (empty = none)
+//           {kQuit}                             -> no reply
+enum : std::int32_t { kQuit = 0, kTable = 1, kPath = 2 };
+
+#if defined(__linux__)
+
+static bool sendAll(int fd, const void* p, std::size_t n) {
+    const char* c = static_cast<const char*>(p);
+    while (n > 0) {
+        ssize_t k = send(fd, c, n, MSG_NOSIGNAL);
+        if (k <= 0) return false;
+        c += k;
+        n -= static_cast<std::size_t>(k);
+    }
+    return true;
+}
+
+static bool recvAll(int fd, void* p, std::size_t n) {
+    char* c = static_cast<char*>(p);
+    while (n > 0) {
+        ssize_t k = recv(fd, c, n, 0);
+        if (k <= 0) return false;
+        c += k;
+        n -= static_cast<std::size_t>(k);
+    }
+    return true;
+}
+
+static bool sendMessage(int fd, const std::vector<std::int32_t>& msg) {
+    std::uint32_t n = static_cast<std::uint32_t>(msg.size());
+    return sendAll(fd, &n, sizeof(n)) && (n == 0 || sendAll(fd, msg.data(), n * sizeof(std::int32_t)));
+}
+
+static bool recvMessage(int fd, std::vector<std::int32_t>& msg) {
+    std::uint32_t n = 0;
+    if (!recvAll(fd, &n, sizeof(n))) return false;
+    msg.resize(n);
+    return n == 0 || recvAll(fd, msg.data(), n * sizeof(std::int32_t));
+}
+
+int RoutingCluster::workerMain(int fd, const std::string& partFile) {
+    Graph g(false);
+    if (!g.loadBinary(partFile)) return 1;
+
+    auto valid = [&](std::int32_t v) { return v >= 0 && v < g.V(); };
+    std::vector<std::int32_t> req, reply;
+    while (recvMessage(fd, req)) {
+        reply.clear();
+        if (req.empty() || req[0] == kQuit) break;
+
+        if (req[0] == kTable && req.size() >= 3 && req[1] >= 0 && req[2] >= 0) {
+            std::size_t nf = static_cast<std::size_t>(req[1]), nt = static_cast<std::size_t>(req[2]);
+            if (req.size() == 3 + nf + nt) {
+                std::vector<int> from(req.begin() + 3, req.begin() + 3 + nf);
+                std::vector<int> to(req.begin() + 3 + nf, req.end());
+                bool ok = true;
+                for (int v : from) ok = ok && valid(v);
+                for (int v : to) ok = ok && valid(v);
+                if (ok) reply = Algorithms::distanceMatrix(g, from, to).d;
+            }
+        } else if (req[0] == kPath && req.size() == 3 && valid(req[1]) && valid(req[2])) {
+            reply = Algorithms::dijkstra(g, req[1], req[2]).path;
+        }
+        if (!sendMessage(fd, reply)) break;
+    }
+    close(fd);
+    return 0;
+}
+
+bool RoutingCluster::start(const Graph& g, int parts, const std::string& dir) {
+    if (running() || g.directed() || g.V() == 0) return false;
+    if (parts < 1) parts = 1;
+    if (parts > g.V()) parts = g.V();
+
+    auto split = Partitioner::bisect(g, parts);
+    cutEdges_ = split.cutEdges;
+    partOf_ = split.partOf;
+    localOf_.assign(g.V(), -1);
+    globalOf_.assign(parts, {});
+    boundaryOf_.assign(parts, {});
+    for (int v=0; v<g.V(); v++) {
+        localOf_[v] = static_cast<int>(globalOf_[partOf_[v]].size());
+        globalOf_[partOf_[v]].push_back(v);
+    }
+    for (int v : split.boundary) boundaryOf_[partOf_[v]].push_back(v);
+
+    std::string pattern = dir + "/routing_XXXXXX";
+    if (!mkdtemp(&pattern[0])) { stop(); return false; }
+    tempDir_ = pattern;
+
+    // one snapshot + one worker per region
+    for (int p=0; p<parts; p++) {
+        std::string file = tempDir_ + "/region_" + std::to_string(p) + ".bin";
+        {
+            Graph sub(false);
+            for (int v : globalOf_[p]) sub.addNode(g.nodeName(v));
+            for (int u : globalOf_[p]) {
+                for (auto e : g.neighbors(u)) {
+                    if (e.to <= u || partOf_[e.to] != p) continue;
+                    sub.addEdge(g.nodeName(u), g.nodeName(e.to), e.w);
+                }
+            }
+            if (!sub.saveBinary(file)) { std::remove(file.c_str()); stop(); return false; }
+        }
+
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) != 0) { std::remove(file.c_str()); stop(); return false; }
+        std::string fdArg = std::to_string(sv[1]);
+        pid_t pid = fork();
+        if (pid == 0) {
+            fcntl(sv[1], F_SETFD, 0); // keep the worker's end across exec
+            execl("/proc/self/exe", "algocity", "--route-worker", fdArg.c_str(), file.c_str(), (char*)nullptr);
+            _exit(127);
+        }
+        close(sv[1]);
+        if (pid < 0) { close(sv[0]); std::remove(file.c_str()); stop(); return false; }
+        workers_.push_back({static_cast<int>(pid), sv[0], file});
+    }
+
+    // overlay: boundary nodes, cut edges, and in-region shortcuts
+    overlayIdx_.assign(g.V(), -1);
+    overlayGlobal_ = split.boundary;
+    for (std::size_t i=0; i<overlayGlobal_.size(); i++) overlayIdx_[overlayGlobal_[i]] = static_cast<int>(i);
+    overlay_.assign(overlayGlobal_.size(), {});
+    for (int u : overlayGlobal_) {
+        for (auto e : g.neighbors(u)) {
+            if (partOf_[e.to] != partOf_[u]) overlay_[overlayIdx_[u]].push_back({overlayIdx_[e.to], e.w});
+        }
+    }
+    for (int p=0; p<parts; p++) {
+        const auto& b = boundaryOf_[p];
+        std::vector<std::int32_t> d;
+        if (!table(p, b, b, d)) { stop(); return false; } // also proves the worker is up
+        for (std::size_t i=0; i<b.size(); i++) {
+            for (std::size_t j=0; j<b.size(); j++) {
+                std::int32_t w = d[i * b.size() + j];
+                if (i != j && w >= 0) overlay_[overlayIdx_[b[i]]].push_back({overlayIdx_[b[j]], w});
+            }
+        }
+    }
+    return true;
+}
+
+void RoutingCluster::stop() {
+    for (auto& w : workers_) {
+        sendMessage(w.fd, {kQuit});
+        close(w.fd);
+        waitpid(static_cast<pid_t>(w.pid), nullptr, 0);
+        std::remove(w.file.c_str());
+    }
+    workers_.clear();
+    if (!tempDir_.empty()) rmdir(tempDir_.c_str());
+    tempDir_.clear();
+    partOf_.clear();
+    localOf_.clear();
+    globalOf_.clear();
+    boundaryOf_.clear();
+    overlayIdx_.clear();
+    overlayGlobal_.clear();
+    overlay_.clear();
+    cutEdges_ = 0;
+}
+
+bool RoutingCluster::call(int part, const std::vector<std::int32_t>& request, std::vector<std::int32_t>& reply) {
+    int fd = workers_[part].fd;
+    return sendMessage(fd, request) && recvMessage(fd, reply);
+}
+
+#else
+
+int RoutingCluster::workerMain(int, const std::string&) { return 1; }
+bool RoutingCluster::start(const Graph&, int, const std::string&) { return false; }
+void RoutingCluster::stop() {}
+bool RoutingCluster::call(int, const std::vector<std::int32_t>&, std::vector<std::int32_t>&) { return false; }
+
+#endif
+
+bool RoutingCluster::table(int part, const std::vector<int>& from, const std::vector<int>& to,
+                           std::vector<std::int32_t>& out) {
+    std::vector<std::int32_t> req{kTable, static_cast<std::int32_t>(from.size()), static_cast<std::int32_t>(to.size())};
+    for (int v : from) req.push_back(localOf_[v]);
+    for (int v : to) req.push_back(localOf_[v]);
+    return call(part, req, out) && out.size() == from.size() * to.size();
+}
+
+bool RoutingCluster::localPath(int part, int a, int b, std::vector<int>& out) {
+    std::vector<std::int32_t> local;
+    if (!call(part, {kPath, localOf_[a], localOf_[b]}, local) || local.empty()) return false;
+    out.clear();
+    for (int v : local) out.push_back(globalOf_[part][v]);
+    return true;
+}
+
+Algorithms::PathResult RoutingCluster::route(int src, int dst) {
+    Algorithms::PathResult res;
+    if (!running() || src < 0 || dst < 0 || src >= (int)partOf_.size() || dst >= (int)partOf_.size()) return res;
+    const int INF = SearchWorkspace::INF;
+    int ps = partOf_[src], pt = partOf_[dst];
+
+    std::vector<std::int32_t> srcLegs, dstLegs, direct;
+    if (!table(ps, {src}, boundaryOf_[ps], srcLegs)) return res;
+    if (!table(pt, {dst}, boundaryOf_[pt], dstLegs)) return res;
+    int best = INF, exit = -1;
+    if (ps == pt && table(ps, {src}, {dst}, direct) && direct[0] >= 0) best = direct[0];
+
+    // multi-source Dijkstra over the overlay, seeded with src's legs
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(static_cast<int>(overlay_.size()));
+    for (std::size_t i=0; i<srcLegs.size(); i++) {
+        int o = overlayIdx_[boundaryOf_[ps][i]];
+        if (srcLegs[i] >= 0 && srcLegs[i] < ws.dist(o)) {
+            ws.set(o, srcLegs[i], -1);
+            ws.push(srcLegs[i], o);
+        }
+    }
+    while (!ws.heapEmpty()) {
+        auto cur = ws.pop();
+        if (cur.d != ws.dist(cur.node)) continue;
+        if (cur.d >= best) break;
+        for (auto e : overlay_[cur.node]) {
+            int nd = cur.d + e.w;
+            if (nd < ws.dist(e.to)) {
+                ws.set(e.to, nd, cur.node);
+                ws.push(nd, e.to);
+            }
+        }
+    }
+    for (std::size_t i=0; i<dstLegs.size(); i++) {
+        int o = overlayIdx_[boundaryOf_[pt][i]];
+        if (dstLegs[i] < 0 || !ws.reached(o)) continue;
+        if (ws.dist(o) + dstLegs[i] < best) { best = ws.dist(o) + dstLegs[i]; exit = o; }
+    }
+    if (best == INF) return res;
+
+    // stitch: src -> entry (local), overlay hops (cut edge or in-region
+    // shortcut expanded by that region's worker), exit -> dst (local)
+    std::vector<int> leg;
+    if (exit < 0) {
+        if (!localPath(ps, src, dst, res.path)) return res;
+    } else {
+        std::vector<int> chain;
+        for (int o=exit; o!=-1; o=ws.parent(o)) chain.push_back(overlayGlobal_[o]);
+        std::reverse(chain.begin(), chain.end());
+
+        if (!localPath(ps, src, chain.front(), res.path)) return res;
+        for (std::size_t i=1; i<chain.size(); i++) {
+            int a = chain[i - 1], b = chain[i];
+            if (partOf_[a] != partOf_[b]) { res.path.push_back(b); continue; }
+            if (!localPath(partOf_[a], a, b, leg)) return {};
+            res.path.insert(res.path.end(), leg.begin() + 1, leg.end());
+        }
+        if (!localPath(pt, chain.back(), dst, leg)) return {};
+        res.path.insert(res.path.end(), leg.begin() + 1, leg.end());
+    }
+    res.reachable = true;
+    res.distance = best;
+    return res;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "structures/graph/Graph.hpp"
+#include "structures/graph/Algorithms.hpp"
+
+// Partitioned routing across local worker processes: a single-host demo of
+// region-split routing, not a distributed service.
+// - start() splits the map into regions (Partitioner), writes one binary
+//   snapshot per region and launches one worker process per region; the
+//   coordinator talks to each over a local socket pair
+// - the coordinator still holds the whole Graph (it partitions it and keeps
+//   per-node region / local id maps), and workers are children of this
+//   executable, so everything runs on one host
+// - Linux only (re-execs /proc/self/exe, uses SOCK_CLOEXEC and
+//   MSG_NOSIGNAL); start() returns false on other platforms
+// - workers answer local queries only: distance tables and paths inside
+//   their region
+// - the coordinator keeps an overlay graph over the boundary nodes (cut
+//   edges + boundary-to-boundary shortcuts reported by the workers) and
+//   stitches cross-region routes through it
+class RoutingCluster {
+public:
+    RoutingCluster() = default;
+    ~RoutingCluster() { stop(); }
+    RoutingCluster(const RoutingCluster&) = delete;
+    RoutingCluster& operator=(const RoutingCluster&) = delete;
+
+    // False if g is directed, already running, or a worker fails to start.
+    // Region snapshots go to a fresh directory under dir (removed by stop()),
+    // so several clusters can share the same dir.
+    bool start(const Graph& g, int parts, const std::string& dir = "data");
+    void stop();
+    bool running() const { return !workers_.empty(); }
+
+    // Ids refer to the graph given to start().
+    Algorithms::PathResult route(int src, int dst);
+
+    int parts() const { return static_cast<int>(workers_.size()); }
+    long long cutEdges() const { return cutEdges_; }
+    std::size_t overlayNodes() const { return overlayGlobal_.size(); }
+
+    // Body of a worker process (dispatched from main): serves the region in
+    // partFile over socket fd until told to quit. Returns the exit code.
+    static int workerMain(int fd, const std::string& partFile);
+
+private:
+    struct Worker {
+        int pid;
+        int fd;
+        std::string file;
+    };
+
+    std::vector<Worker> workers_;
+    std::string tempDir_;                         // holds the region snapshots while running
+    std::vector<int> partOf_;                     // global id -> region
+    std::vector<int> localOf_;                    // global id -> id inside its region
+    std::vector<std::vector<int>> globalOf_;      // region -> local id -> global id
+    std::vector<std::vector<int>> boundaryOf_;    // region -> boundary nodes (global ids)
+    std::vector<int> overlayIdx_;                 // global id -> overlay node, -1 if interior
+    std::vector<int> overlayGlobal_;              // overlay node -> global id
+    std::vector<std::vector<Graph::Edge>> overlay_;
+    long long cutEdges_{0};
+
+    bool call(int part, const std::vector<std::int32_t>& request, std::vector<std::int32_t>& reply);
+    bool table(int part, const std::vector<int>& from, const std::vector<int>& to, std::vector<std::int32_t>& out);
+    bool localPath(int part, int a, int b, std::vector<int>& out); // global ids, a..b
+};
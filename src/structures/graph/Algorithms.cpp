@@ -1,126 +1,649 @@
 #include "structures/graph/Algorithms.hpp"
-#include <queue>
-#include <limits>
+#include "structures/graph/UnionFind.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
 
 namespace Algorithms {
 
-std::vector<int> bfs(const Graph& g, int start) {
-    std::vector<int> order;
-    std::vector<bool> vis(g.V(), false);
-    std::queue<int> q;
-
-    vis[start] = true;
-    q.push(start);
+std::vector<int> bfs(const Graph& g, int start, SearchWorkspace& ws) {
+    ws.begin(g.V());
+    std::vector<int> order{start}; // doubles as the FIFO queue
+    ws.markDone(start);
 
-    while (!q.empty()) {
-        int u = q.front(); q.pop();
-        order.push_back(u);
+    for (std::size_t head=0; head<order.size(); head++) {
+        int u = order[head];
         for (auto e : g.neighbors(u)) {
-            if (!vis[e.to]) {
-                vis[e.to] = true;
-                q.push(e.to);
+            if (!ws.done(e.to)) {
+                ws.markDone(e.to);
+                order.push_back(e.to);
             }
         }
     }
     return order;
 }
 
-static bool dfsCycle(const Graph& g, int u, std::vector<int>& state) {
-    state[u] = 1;
-    for (auto e : g.neighbors(u)) {
-        int v = e.to;
-        if (state[v] == 1) return true;
-        if (state[v] == 0 && dfsCycle(g, v, state)) return true;
+// Direction-optimizing BFS (Beamer et al.):
+// - top-down: frontier nodes claim unvisited neighbours (atomic bitmap)
+// - bottom-up: every unvisited node looks for any parent in the frontier
+// We go bottom-up once the frontier's edges outweigh the unexplored ones
+// and come back when the frontier has shrunk to a small fraction of V.
+static const std::size_t kTopDownGrain = 256;   // frontier nodes per chunk
+static const std::size_t kBottomUpGrain = 4096; // node ids per chunk (multiple of 64)
+static const long long kAlpha = 14;
+static const long long kBeta = 24;
+
+std::vector<int> bfsLevels(const Graph& g, int start) {
+    const int n = g.V();
+    std::vector<int> dist(n, -1);
+    if (start < 0 || start >= n) return dist;
+
+    const std::size_t words = (static_cast<std::size_t>(n) + 63) / 64;
+    std::vector<std::atomic<std::uint64_t>> visited(words);
+    for (auto& w : visited) w.store(0, std::memory_order_relaxed);
+
+    auto claim = [&](int v) {
+        std::uint64_t bit = 1ULL << (v & 63);
+        return (visited[v >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    };
+    auto seen = [&](int v) {
+        return (visited[v >> 6].load(std::memory_order_relaxed) >> (v & 63)) & 1ULL;
+    };
+    auto degree = [&](int v) { return static_cast<long long>(g.neighbors(v).size()); };
+
+    long long unexplored = 0;
+    for (int u=0; u<n; u++) unexplored += degree(u);
+
+    claim(start);
+    dist[start] = 0;
+    unexplored -= degree(start);
+
+    std::vector<int> frontier{start};          // top-down representation
+    std::vector<std::uint64_t> frontBits;      // bottom-up representation
+    long long frontierSize = 1, prevSize = 0;
+    long long frontierEdges = degree(start);
+    bool bottomUp = false;
+
+    for (int level = 0; frontierSize > 0; level++) {
+        if (!g.directed()) {
+            if (!bottomUp && frontierEdges > unexplored / kAlpha) {
+                frontBits.assign(words, 0);
+                for (int u : frontier) frontBits[u >> 6] |= 1ULL << (u & 63);
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < n / kBeta && frontierSize < prevSize) {
+                frontier.clear();
+                for (std::size_t w=0; w<words; w++) {
+                    for (std::uint64_t bits = frontBits[w]; bits; bits &= bits - 1) {
+                        frontier.push_back(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+                    }
+                }
+                bottomUp = false;
+            }
+        }
+        prevSize = frontierSize;
+
+        if (!bottomUp) {
+            std::size_t chunks = (frontier.size() + kTopDownGrain - 1) / kTopDownGrain;
+            std::vector<std::vector<int>> found(chunks);
+            std::vector<long long> edges(chunks, 0);
+            Parallel::forRange(frontier.size(), kTopDownGrain, [&](std::size_t b, std::size_t e) {
+                std::size_t c = b / kTopDownGrain;
+                for (std::size_t i=b; i<e; i++) {
+                    for (auto ed : g.neighbors(frontier[i])) {
+                        int v = ed.to;
+                        if (seen(v) || !claim(v)) continue;
+                        dist[v] = level + 1;
+                        found[c].push_back(v);
+                        edges[c] += degree(v);
+                    }
+                }
+            });
+            frontier.clear();
+            frontierEdges = 0;
+            for (std::size_t c=0; c<chunks; c++) {
+                frontier.insert(frontier.end(), found[c].begin(), found[c].end());
+                frontierEdges += edges[c];
+            }
+            frontierSize = static_cast<long long>(frontier.size());
+        } else {
+            std::vector<std::uint64_t> nextBits(words, 0);
+            std::size_t chunks = (static_cast<std::size_t>(n) + kBottomUpGrain - 1) / kBottomUpGrain;
+            std::vector<long long> count(chunks, 0), edges(chunks, 0);
+            // chunks are 64-aligned, so each bitmap word has a single writer
+            Parallel::forRange(n, kBottomUpGrain, [&](std::size_t b, std::size_t e) {
+                std::size_t c = b / kBottomUpGrain;
+                for (std::size_t vi=b; vi<e; vi++) {
+                    int v = static_cast<int>(vi);
+                    if (seen(v)) continue;
+                    for (auto ed : g.neighbors(v)) {
+                        int u = ed.to;
+                        if (!((frontBits[u >> 6] >> (u & 63)) & 1ULL)) continue;
+                        dist[v] = level + 1;
+                        claim(v);
+                        nextBits[v >> 6] |= 1ULL << (v & 63);
+                        count[c]++;
+                        edges[c] += degree(v);
+                        break;
+                    }
+                }
+            });
+            frontBits.swap(nextBits);
+            frontierSize = 0;
+            frontierEdges = 0;
+            for (std::size_t c=0; c<chunks; c++) {
+                frontierSize += count[c];
+                frontierEdges += edges[c];
+            }
+        }
+        unexplored -= frontierEdges;
     }
-    state[u] = 2;
-    return false;
+    return dist;
 }
 
-bool hasDirectedCycle(const Graph& g) {
-    std::vector<int> state(g.V(), 0);
-    for (int u=0; u<g.V(); u++) {
-        if (state[u] == 0 && dfsCycle(g, u, state)) return true;
+// Farthest node (ties: lowest degree) of the BFS from `from`, restricted
+// to nodes not yet numbered.
+static int farthestFrom(const Graph& g, int from, const std::vector<char>& done,
+                        std::vector<int>& level, std::vector<int>& q) {
+    q.assign(1, from);
+    level[from] = 0;
+    int best = from;
+    for (std::size_t i=0; i<q.size(); i++) {
+        int u = q[i];
+        if (level[u] > level[best] ||
+            (level[u] == level[best] && g.neighbors(u).size() < g.neighbors(best).size())) best = u;
+        for (auto e : g.neighbors(u)) {
+            if (done[e.to] || level[e.to] >= 0) continue;
+            level[e.to] = level[u] + 1;
+            q.push_back(e.to);
+        }
+    }
+    for (int u : q) level[u] = -1;
+    return best;
+}
+
+std::vector<int> rcmOrder(const Graph& g) {
+    const int n = g.V();
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> done(n, 0);
+    std::vector<int> level(n, -1), q, nbrs;
+
+    // components in order of their lowest-degree node
+    std::vector<int> byDegree(n);
+    for (int i=0; i<n; i++) byDegree[i] = i;
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) {
+        return g.neighbors(a).size() < g.neighbors(b).size();
+    });
+
+    for (int seed : byDegree) {
+        if (done[seed]) continue;
+        int root = farthestFrom(g, seed, done, level, q);
+        root = farthestFrom(g, root, done, level, q);
+
+        std::size_t head = order.size();
+        order.push_back(root);
+        done[root] = 1;
+        for (; head < order.size(); head++) {
+            int u = order[head];
+            nbrs.clear();
+            for (auto e : g.neighbors(u)) {
+                if (!done[e.to]) { done[e.to] = 1; nbrs.push_back(e.to); }
+            }
+            std::sort(nbrs.begin(), nbrs.end(), [&](int a, int b) {
+                return g.neighbors(a).size() < g.neighbors(b).size();
+            });
+            order.insert(order.end(), nbrs.begin(), nbrs.end());
+        }
+    }
+
+    std::vector<int> newId(n);
+    for (int i=0; i<n; i++) newId[order[i]] = n - 1 - i;
+    return newId;
+}
+
+// Position of (x, y) along a Hilbert curve filling a 2^16 x 2^16 grid.
+static std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y) {
+    const std::uint32_t n = 1u << 16;
+    std::uint64_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) { // rotate the quadrant
+            if (rx == 1) { x = n - 1 - x; y = n - 1 - y; }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+std::vector<int> hilbertOrder(const Graph& g) {
+    const int n = g.V();
+    if (n == 0) return {};
+    for (int v=0; v<n; v++) if (!g.hasCoord(v)) return {};
+
+    double minX = g.coordX(0), maxX = minX, minY = g.coordY(0), maxY = minY;
+    for (int v=1; v<n; v++) {
+        minX = std::min(minX, g.coordX(v)); maxX = std::max(maxX, g.coordX(v));
+        minY = std::min(minY, g.coordY(v)); maxY = std::max(maxY, g.coordY(v));
+    }
+    double span = std::max(maxX - minX, maxY - minY);
+    double scale = span > 0 ? 65535.0 / span : 0.0;
+
+    std::vector<std::pair<std::uint64_t,int>> keyed(n);
+    for (int v=0; v<n; v++) {
+        auto gx = static_cast<std::uint32_t>((g.coordX(v) - minX) * scale);
+        auto gy = static_cast<std::uint32_t>((g.coordY(v) - minY) * scale);
+        keyed[v] = {hilbertIndex(gx, gy), v};
     }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<int> newId(n);
+    for (int i=0; i<n; i++) newId[keyed[i].second] = i;
+    return newId;
+}
+
+bool hasDirectedCycle(const Graph& g) {
+    auto scc = stronglyConnected(g);
+    for (int c=0; c<scc.count; c++) if (scc.cyclic[c]) return true;
     return false;
 }
 
-struct HeapItem { int d; int node; };
-struct MinCmp { bool operator()(const HeapItem& a, const HeapItem& b) const { return a.d > b.d; } };
+SCCResult stronglyConnected(const Graph& g) {
+    const int n = g.V();
+    SCCResult res;
+    res.comp.assign(n, -1);
+
+    std::vector<int> index(n, -1), low(n, 0), stack;
+    std::vector<char> onStack(n, 0);
+    struct Frame { int node; std::size_t next; };
+    std::vector<Frame> calls;
+    int counter = 0, found = 0;
+
+    for (int root=0; root<n; root++) {
+        if (index[root] >= 0) continue;
+        calls.push_back({root, 0});
+        index[root] = low[root] = counter++;
+        stack.push_back(root);
+        onStack[root] = 1;
+
+        while (!calls.empty()) {
+            Frame& f = calls.back();
+            int u = f.node;
+            const auto& nbrs = g.neighbors(u);
+            if (f.next < nbrs.size()) {
+                int v = nbrs[f.next++].to;
+                if (index[v] < 0) {
+                    index[v] = low[v] = counter++;
+                    stack.push_back(v);
+                    onStack[v] = 1;
+                    calls.push_back({v, 0}); // invalidates f
+                } else if (onStack[v] && index[v] < low[u]) {
+                    low[u] = index[v];
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty()) {
+                int p = calls.back().node;
+                if (low[u] < low[p]) low[p] = low[u];
+            }
+            if (low[u] == index[u]) {
+                int v;
+                do {
+                    v = stack.back();
+                    stack.pop_back();
+                    onStack[v] = 0;
+                    res.comp[v] = found;
+                } while (v != u);
+                found++;
+            }
+        }
+    }
+
+    // Tarjan emits sinks first; flip to topological order.
+    res.count = found;
+    for (int& c : res.comp) c = found - 1 - c;
+
+    res.memberStart.assign(found + 1, 0);
+    for (int v=0; v<n; v++) res.memberStart[res.comp[v] + 1]++;
+    for (int c=0; c<found; c++) res.memberStart[c + 1] += res.memberStart[c];
+    res.members.resize(n);
+    std::vector<int> fill(res.memberStart.begin(), res.memberStart.end() - 1);
+    for (int v=0; v<n; v++) res.members[fill[res.comp[v]]++] = v;
+
+    res.cyclic.assign(found, 0);
+    res.dagStart.assign(found + 1, 0);
+    std::vector<int> lastFrom(found, -1);
+    for (int c=0; c<found; c++) {
+        if (res.size(c) > 1) res.cyclic[c] = 1;
+        for (int k=res.memberStart[c]; k<res.memberStart[c + 1]; k++) {
+            int u = res.members[k];
+            for (auto e : g.neighbors(u)) {
+                int d = res.comp[e.to];
+                if (d == c) {
+                    if (e.to == u) res.cyclic[c] = 1;
+                    continue;
+                }
+                if (lastFrom[d] == c) continue;
+                lastFrom[d] = c;
+                res.dagTo.push_back(d);
+            }
+        }
+        res.dagStart[c + 1] = static_cast<int>(res.dagTo.size());
+    }
+    return res;
+}
+
+std::vector<int> cycleIn(const Graph& g, const SCCResult& scc, int c) {
+    if (c < 0 || c >= scc.count || !scc.cyclic[c]) return {};
+    // members of a component are stored in increasing id order, so a node's
+    // slot in the component is a binary search away (no O(V) scratch)
+    auto first = scc.members.begin() + scc.memberStart[c];
+    auto last = scc.members.begin() + scc.memberStart[c + 1];
+    auto slot = [&](int v) { return static_cast<int>(std::lower_bound(first, last, v) - first); };
 
-PathResult dijkstra(const Graph& g, int src, int dst) {
-    const int INF = std::numeric_limits<int>::max() / 4;
-    std::vector<int> dist(g.V(), INF);
-    std::vector<int> parent(g.V(), -1);
+    // BFS inside the component until an edge leads back to start
+    int start = *first;
+    std::vector<int> q{start};
+    std::vector<int> parent(scc.size(c), -2);
+    parent[slot(start)] = -1;
+    for (std::size_t i=0; i<q.size(); i++) {
+        int u = q[i];
+        for (auto e : g.neighbors(u)) {
+            int v = e.to;
+            if (scc.comp[v] != c) continue;
+            if (v == start) {
+                std::vector<int> rev{start};
+                for (int cur=u; cur!=-1; cur=parent[slot(cur)]) rev.push_back(cur);
+                return std::vector<int>(rev.rbegin(), rev.rend());
+            }
+            int sv = slot(v);
+            if (parent[sv] != -2) continue;
+            parent[sv] = u;
+            q.push_back(v);
+        }
+    }
+    return {};
+}
 
-    std::priority_queue<HeapItem, std::vector<HeapItem>, MinCmp> pq;
-    dist[src] = 0;
-    pq.push({0, src});
+PathResult dijkstra(const Graph& g, int src, int dst, SearchWorkspace& ws) {
+    ws.begin(g.V());
+    ws.set(src, 0, -1);
+    ws.push(0, src);
 
-    while (!pq.empty()) {
-        auto cur = pq.top(); pq.pop();
+    while (!ws.heapEmpty()) {
+        auto cur = ws.pop();
         int d = cur.d, u = cur.node;
-        if (d != dist[u]) continue;
+        if (d != ws.dist(u)) continue;
         if (u == dst) break;
 
         for (auto e : g.neighbors(u)) {
             int v = e.to;
-            int nd = dist[u] + e.w;
-            if (nd < dist[v]) {
-                dist[v] = nd;
-                parent[v] = u;
-                pq.push({nd, v});
+            int nd = d + e.w;
+            if (nd < ws.dist(v)) {
+                ws.set(v, nd, u);
+                ws.push(nd, v);
             }
         }
     }
 
     PathResult res;
-    if (dist[dst] == INF) return res;
+    if (!ws.reached(dst)) return res;
     res.reachable = true;
-    res.distance = dist[dst];
+    res.distance = ws.dist(dst);
 
     // reconstruct
     std::vector<int> rev;
-    for (int cur=dst; cur!=-1; cur=parent[cur]) rev.push_back(cur);
+    for (int cur=dst; cur!=-1; cur=ws.parent(cur)) rev.push_back(cur);
     res.path.assign(rev.rbegin(), rev.rend());
     return res;
 }
 
-MSTResult primMST(const Graph& g, int start) {
-    const int INF = std::numeric_limits<int>::max() / 4;
-    std::vector<int> key(g.V(), INF);
-    std::vector<int> parent(g.V(), -1);
-    std::vector<bool> in(g.V(), false);
+// Settles nodes in distance order until visit() returns false.
+template <typename Visit>
+static void settleInOrder(const Graph& g, int src, SearchWorkspace& ws, Visit&& visit) {
+    ws.begin(g.V());
+    ws.set(src, 0, -1);
+    ws.push(0, src);
+    while (!ws.heapEmpty()) {
+        auto cur = ws.pop();
+        int d = cur.d, u = cur.node;
+        if (d != ws.dist(u)) continue;
+        if (!visit(u, d)) return;
+
+        for (auto e : g.neighbors(u)) {
+            int nd = d + e.w;
+            if (nd < ws.dist(e.to)) {
+                ws.set(e.to, nd, u);
+                ws.push(nd, e.to);
+            }
+        }
+    }
+}
+
+std::vector<Reached> withinDistance(const Graph& g, int src, int budget, SearchWorkspace& ws) {
+    std::vector<Reached> out;
+    settleInOrder(g, src, ws, [&](int u, int d) {
+        if (d > budget) return false;
+        out.push_back({u, d});
+        return true;
+    });
+    return out;
+}
 
-    std::priority_queue<HeapItem, std::vector<HeapItem>, MinCmp> pq;
-    key[start] = 0;
-    pq.push({0, start});
+std::vector<Reached> nearestK(const Graph& g, int src, int k, const std::function<bool(int)>& isTarget,
+                              SearchWorkspace& ws) {
+    std::vector<Reached> out;
+    if (k <= 0) return out;
+    settleInOrder(g, src, ws, [&](int u, int d) {
+        if (isTarget(u)) out.push_back({u, d});
+        return (int)out.size() < k;
+    });
+    return out;
+}
 
-    while (!pq.empty()) {
-        auto cur = pq.top(); pq.pop();
+DistanceMatrix distanceMatrix(const Graph& g, const std::vector<int>& sources,
+                              const std::vector<int>& targets) {
+    DistanceMatrix res;
+    res.rows = static_cast<int>(sources.size());
+    res.cols = static_cast<int>(targets.size());
+    res.d.assign(static_cast<std::size_t>(res.rows) * res.cols, -1);
+    if (res.d.empty()) return res;
+
+    std::vector<char> isTarget(g.V(), 0);
+    int distinctTargets = 0;
+    for (int t : targets) {
+        if (!isTarget[t]) { isTarget[t] = 1; distinctTargets++; }
+    }
+
+    Parallel::forRange(sources.size(), 1, [&](std::size_t b, std::size_t e) {
+        SearchWorkspace& ws = SearchWorkspace::local();
+        for (std::size_t r=b; r<e; r++) {
+            ws.begin(g.V());
+            int remaining = distinctTargets;
+            ws.set(sources[r], 0, -1);
+            ws.push(0, sources[r]);
+
+            while (!ws.heapEmpty() && remaining > 0) {
+                auto cur = ws.pop();
+                int d = cur.d, u = cur.node;
+                if (d != ws.dist(u)) continue;
+                if (isTarget[u]) remaining--;
+
+                for (auto ed : g.neighbors(u)) {
+                    int nd = d + ed.w;
+                    if (nd < ws.dist(ed.to)) {
+                        ws.set(ed.to, nd, u);
+                        ws.push(nd, ed.to);
+                    }
+                }
+            }
+
+            int* row = &res.d[r * res.cols];
+            for (int c=0; c<res.cols; c++) {
+                row[c] = ws.reached(targets[c]) ? ws.dist(targets[c]) : -1;
+            }
+        }
+    });
+    return res;
+}
+
+MSTResult primMST(const Graph& g, int start, SearchWorkspace& ws) {
+    // ws.dist = key (cheapest link into the tree), ws.done = in tree
+    ws.begin(g.V());
+    ws.set(start, 0, -1);
+    ws.push(0, start);
+
+    MSTResult res;
+    res.parent.assign(g.V(), -1);
+    while (!ws.heapEmpty()) {
+        auto cur = ws.pop();
         int u = cur.node;
-        if (in[u]) continue;
-        in[u] = true;
+        if (ws.done(u)) continue;
+        ws.markDone(u);
+        res.parent[u] = ws.parent(u);
+        if (u != start) res.totalCost += ws.dist(u);
 
         for (auto e : g.neighbors(u)) {
             int v = e.to;
-            if (!in[v] && e.w < key[v]) {
-                key[v] = e.w;
-                parent[v] = u;
-                pq.push({key[v], v});
+            if (!ws.done(v) && e.w < ws.dist(v)) {
+                ws.set(v, e.w, u);
+                ws.push(e.w, v);
             }
         }
     }
+    res.components = 1;
+    return res;
+}
+
+struct WEdge { int u; int v; int w; };
+
+// Every undirected edge once (u < v), every directed edge as-is; no self-loops.
+static std::vector<WEdge> edgeList(const Graph& g) {
+    std::vector<WEdge> edges;
+    for (int u=0; u<g.V(); u++) {
+        for (auto e : g.neighbors(u)) {
+            if (e.to == u || (!g.directed() && e.to < u)) continue;
+            edges.push_back({u, e.to, e.w});
+        }
+    }
+    return edges;
+}
 
+// Roots each tree of the chosen edges to fill parent[] (BFS per tree).
+static MSTResult forestFromEdges(const Graph& g, const std::vector<WEdge>& chosen) {
     MSTResult res;
-    res.parent = parent;
-    long long sum = 0;
-    for (int i=0;i<g.V();i++) {
-        if (i == start) continue;
-        if (key[i] != INF) sum += key[i];
+    res.parent.assign(g.V(), -1);
+
+    std::vector<int> start(g.V() + 1, 0), to(chosen.size() * 2);
+    for (const auto& e : chosen) { start[e.u + 1]++; start[e.v + 1]++; }
+    for (int i=0; i<g.V(); i++) start[i + 1] += start[i];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (const auto& e : chosen) {
+        to[fill[e.u]++] = e.v;
+        to[fill[e.v]++] = e.u;
+        res.totalCost += e.w;
+    }
+
+    std::vector<char> seen(g.V(), 0);
+    std::vector<int> q;
+    for (int r=0; r<g.V(); r++) {
+        if (seen[r]) continue;
+        res.components++;
+        seen[r] = 1;
+        q.assign(1, r);
+        for (std::size_t i=0; i<q.size(); i++) {
+            int u = q[i];
+            for (int k=start[u]; k<start[u + 1]; k++) {
+                int v = to[k];
+                if (seen[v]) continue;
+                seen[v] = 1;
+                res.parent[v] = u;
+                q.push_back(v);
+            }
+        }
     }
-    res.totalCost = (int)sum;
     return res;
 }
 
+MSTResult kruskalMST(const Graph& g) {
+    auto edges = edgeList(g);
+    std::sort(edges.begin(), edges.end(), [](const WEdge& a, const WEdge& b){ return a.w < b.w; });
+
+    UnionFind uf(g.V());
+    std::vector<WEdge> chosen;
+    for (const auto& e : edges) {
+        if (uf.unite(e.u, e.v)) {
+            chosen.push_back(e);
+            if (uf.sets() == 1) break;
+        }
+    }
+    return forestFromEdges(g, chosen);
+}
+
+// Boruvka rounds: every component picks its cheapest outgoing edge (ties by
+// edge index, so picks never form a cycle), picks are merged, and edges that
+// became internal are dropped. The edge scans run on the worker pool.
+static const std::size_t kEdgeGrain = 1 << 14;
+
+MSTResult boruvkaMST(const Graph& g) {
+    const std::uint64_t NONE = ~0ULL;
+    auto edges = edgeList(g);
+    // the index has to fit the low 32 bits (and never pack into NONE)
+    if (edges.size() >= 0xffffffffULL) throw std::length_error("boruvkaMST: too many edges");
+    std::vector<int> comp(g.V());
+    for (int i=0; i<g.V(); i++) comp[i] = i;
+    std::vector<std::atomic<std::uint64_t>> best(g.V());
+
+    UnionFind uf(g.V());
+    std::vector<WEdge> chosen;
+
+    while (!edges.empty()) {
+        for (auto& b : best) b.store(NONE, std::memory_order_relaxed);
+
+        Parallel::forRange(edges.size(), kEdgeGrain, [&](std::size_t b, std::size_t e) {
+            for (std::size_t i=b; i<e; i++) {
+                // (weight, index) packed so that unsigned order = edge order
+                std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(edges[i].w) ^ 0x80000000u) << 32) | (i & 0xffffffffULL);
+                for (int c : {comp[edges[i].u], comp[edges[i].v]}) {
+                    std::uint64_t cur = best[c].load(std::memory_order_relaxed);
+                    while (key < cur && !best[c].compare_exchange_weak(cur, key, std::memory_order_relaxed)) {}
+                }
+            }
+        });
+
+        for (int c=0; c<g.V(); c++) {
+            std::uint64_t key = best[c].load(std::memory_order_relaxed);
+            if (key == NONE) continue;
+            const WEdge& e = edges[key & 0xffffffffULL];
+            if (uf.unite(e.u, e.v)) chosen.push_back(e);
+        }
+        for (int v=0; v<g.V(); v++) comp[v] = uf.find(v);
+
+        // drop edges that are now inside one component
+        std::size_t chunks = (edges.size() + kEdgeGrain - 1) / kEdgeGrain;
+        std::vector<std::size_t> kept(chunks, 0);
+        Parallel::forRange(edges.size(), kEdgeGrain, [&](std::size_t b, std::size_t e) {
+            std::size_t out = b;
+            for (std::size_t i=b; i<e; i++) {
+                if (comp[edges[i].u] != comp[edges[i].v]) edges[out++] = edges[i];
+            }
+            kept[b / kEdgeGrain] = out - b;
+        });
+        std::size_t n = 0;
+        for (std::size_t c=0; c<chunks; c++) {
+            std::size_t b = c * kEdgeGrain;
+            if (n != b) std::move(edges.begin() + b, edges.begin() + b + kept[c], edges.begin() + n);
+            n += kept[c];
+        }
+        edges.resize(n);
+    }
+    return forestFromEdges(g, chosen);
+}
+
 }
 
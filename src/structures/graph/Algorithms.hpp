@@ -1,126 +1,98 @@
-#include "structures/graph/Algorithms.hpp"
-#include <queue>
-#include <limits>
+#pragma once
+#include <vector>
+#include <functional>
+#include "structures/graph/Graph.hpp"
+#include "structures/graph/SearchWorkspace.hpp"
 
 namespace Algorithms {
-
-std::vector<int> bfs(const Graph& g, int start) {
-    std::vector<int> order;
-    std::vector<bool> vis(g.V(), false);
-    std::queue<int> q;
-
-    vis[start] = true;
-    q.push(start);
-
-    while (!q.empty()) {
-        int u = q.front(); q.pop();
-        order.push_back(u);
-        for (auto e : g.neighbors(u)) {
-            if (!vis[e.to]) {
-                vis[e.to] = true;
-                q.push(e.to);
-            }
-        }
-    }
-    return order;
-}
-
-static bool dfsCycle(const Graph& g, int u, std::vector<int>& state) {
-    state[u] = 1;
-    for (auto e : g.neighbors(u)) {
-        int v = e.to;
-        if (state[v] == 1) return true;
-        if (state[v] == 0 && dfsCycle(g, v, state)) return true;
-    }
-    state[u] = 2;
-    return false;
-}
-
-bool hasDirectedCycle(const Graph& g) {
-    std::vector<int> state(g.V(), 0);
-    for (int u=0; u<g.V(); u++) {
-        if (state[u] == 0 && dfsCycle(g, u, state)) return true;
-    }
-    return false;
-}
-
-struct HeapItem { int d; int node; };
-struct MinCmp { bool operator()(const HeapItem& a, const HeapItem& b) const { return a.d > b.d; } };
-
-PathResult dijkstra(const Graph& g, int src, int dst) {
-    const int INF = std::numeric_limits<int>::max() / 4;
-    std::vector<int> dist(g.V(), INF);
-    std::vector<int> parent(g.V(), -1);
-
-    std::priority_queue<HeapItem, std::vector<HeapItem>, MinCmp> pq;
-    dist[src] = 0;
-    pq.push({0, src});
-
-    while (!pq.empty()) {
-        auto cur = pq.top(); pq.pop();
-        int d = cur.d, u = cur.node;
-        if (d != dist[u]) continue;
-        if (u == dst) break;
-
-        for (auto e : g.neighbors(u)) {
-            int v = e.to;
-            int nd = dist[u] + e.w;
-            if (nd < dist[v]) {
-                dist[v] = nd;
-                parent[v] = u;
-                pq.push({nd, v});
-            }
-        }
-    }
-
-    PathResult res;
-    if (dist[dst] == INF) return res;
-    res.reachable = true;
-    res.distance = dist[dst];
-
-    // reconstruct
-    std::vector<int> rev;
-    for (int cur=dst; cur!=-1; cur=parent[cur]) rev.push_back(cur);
-    res.path.assign(rev.rbegin(), rev.rend());
-    return res;
-}
-
-MSTResult primMST(const Graph& g, int start) {
-    const int INF = std::numeric_limits<int>::max() / 4;
-    std::vector<int> key(g.V(), INF);
-    std::vector<int> parent(g.V(), -1);
-    std::vector<bool> in(g.V(), false);
-
-    std::priority_queue<HeapItem, std::vector<HeapItem>, MinCmp> pq;
-    key[start] = 0;
-    pq.push({0, start});
-
-    while (!pq.empty()) {
-        auto cur = pq.top(); pq.pop();
-        int u = cur.node;
-        if (in[u]) continue;
-        in[u] = true;
-
-        for (auto e : g.neighbors(u)) {
-            int v = e.to;
-            if (!in[v] && e.w < key[v]) {
-                key[v] = e.w;
-                parent[v] = u;
-                pq.push({key[v], v});
-            }
-        }
-    }
-
-    MSTResult res;
-    res.parent = parent;
-    long long sum = 0;
-    for (int i=0;i<g.V();i++) {
-        if (i == start) continue;
-        if (key[i] != INF) sum += key[i];
-    }
-    res.totalCost = (int)sum;
-    return res;
+    struct PathResult {
+        bool reachable{false};
+        int distance{0};
+        std::vector<int> path; // node ids, src..dst
+    };
+
+    struct MSTResult {
+        std::vector<int> parent; // parent[v] in the tree, -1 for root/unreached
+        long long totalCost{0};
+        int components{0};       // trees in the result (Prim: 1)
+    };
+
+    struct Reached {
+        int node;
+        int dist;
+    };
+
+    // Dense rows x cols table, row-major; -1 = unreachable.
+    struct DistanceMatrix {
+        int rows{0};
+        int cols{0};
+        std::vector<int> d;
+
+        int at(int r, int c) const { return d[static_cast<std::size_t>(r) * cols + c]; }
+    };
+
+    // Strongly connected components, numbered in topological order of the
+    // condensation DAG. Members and DAG edges are stored CSR-style.
+    struct SCCResult {
+        int count{0};
+        std::vector<int> comp;        // node -> component
+        std::vector<int> memberStart; // members of c: members[memberStart[c] .. memberStart[c+1])
+        std::vector<int> members;
+        std::vector<int> dagStart;    // DAG edges of c: dagTo[dagStart[c] .. dagStart[c+1]), deduplicated
+        std::vector<int> dagTo;
+        std::vector<char> cyclic;     // c has more than one node or a self-loop
+
+        int size(int c) const { return memberStart[c + 1] - memberStart[c]; }
+    };
+
+    // Single-source searches take a reusable SearchWorkspace (defaulting to
+    // the calling thread's), so short queries on huge graphs only pay for
+    // the nodes they touch.
+
+    // Visit order from start (sequential queue BFS).
+    std::vector<int> bfs(const Graph& g, int start, SearchWorkspace& ws = SearchWorkspace::local());
+
+    // Hop distance from start to every node (-1 = unreachable).
+    // Direction-optimizing (top-down / bottom-up) and parallel over the
+    // frontier; bottom-up steps are only taken on undirected graphs.
+    std::vector<int> bfsLevels(const Graph& g, int start);
+
+    bool hasDirectedCycle(const Graph& g);
+
+    // Iterative Tarjan (no recursion, O(V+E)) plus the condensation DAG.
+    SCCResult stronglyConnected(const Graph& g);
+    // One concrete cycle inside cyclic component c: u0 -> ... -> u0.
+    std::vector<int> cycleIn(const Graph& g, const SCCResult& scc, int c);
+
+    // Reverse Cuthill-McKee numbering (newId[v]) for Graph::renumber():
+    // per component, BFS from a pseudo-peripheral node visiting neighbours
+    // by increasing degree, then reversed. Neighbouring intersections get
+    // nearby ids, so dist/parent arrays are walked with better locality.
+    std::vector<int> rcmOrder(const Graph& g);
+    // Hilbert-curve numbering from node coordinates (nearby on the map =>
+    // nearby ids); empty if some node has no coordinates.
+    std::vector<int> hilbertOrder(const Graph& g);
+
+    PathResult dijkstra(const Graph& g, int src, int dst, SearchWorkspace& ws = SearchWorkspace::local());
+
+    // Bounded Dijkstra variants: they stop as soon as the budget / k-th hit
+    // is settled, so work follows the explored region rather than V.
+    // Results are nearest first.
+    std::vector<Reached> withinDistance(const Graph& g, int src, int budget,
+                                        SearchWorkspace& ws = SearchWorkspace::local());
+    std::vector<Reached> nearestK(const Graph& g, int src, int k, const std::function<bool(int)>& isTarget,
+                                  SearchWorkspace& ws = SearchWorkspace::local());
+
+    // Many-to-many distances: one Dijkstra per source, sources spread over
+    // the worker pool, each search stopping once all targets are settled.
+    DistanceMatrix distanceMatrix(const Graph& g, const std::vector<int>& sources,
+                                  const std::vector<int>& targets);
+
+    // Prim covers start's component only; Kruskal and Boruvka return a
+    // minimum spanning forest over every component (edges are treated as
+    // undirected). Boruvka scans edges in parallel on the worker pool
+    // (std::length_error from 2^32 - 1 edges on).
+    MSTResult primMST(const Graph& g, int start, SearchWorkspace& ws = SearchWorkspace::local());
+    MSTResult kruskalMST(const Graph& g);
+    MSTResult boruvkaMST(const Graph& g);
 }
-
-}
-
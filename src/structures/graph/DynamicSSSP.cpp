@@ -0,0 +1,135 @@
+#include "structures/graph/DynamicSSSP.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+static const int INF = std::numeric_limits<int>::max() / 4;
+
+DynamicSSSP::DynamicSSSP(const Graph& g, int source) : g_(&g), source_(source) {
+    if (g.directed()) throw std::invalid_argument("DynamicSSSP: graph must be undirected");
+    if (source < 0 || source >= g.V()) throw std::out_of_range("DynamicSSSP: bad source id");
+    recompute();
+}
+
+int DynamicSSSP::distance(int v) const {
+    if (v < 0 || v >= (int)dist_.size() || dist_[v] == INF) return -1;
+    return dist_[v];
+}
+
+std::vector<int> DynamicSSSP::pathTo(int v) const {
+    if (distance(v) < 0) return {};
+    std::vector<int> rev;
+    for (int cur=v; cur!=-1; cur=parent_[cur]) rev.push_back(cur);
+    return std::vector<int>(rev.rbegin(), rev.rend());
+}
+
+void DynamicSSSP::recompute() {
+    dist_.assign(g_->V(), INF);
+    parent_.assign(g_->V(), -1);
+    inSubtree_.assign(g_->V(), 0);
+    heap_.clear();
+    dist_[source_] = 0;
+    push(0, source_);
+    lastRepair_ = settle(false);
+}
+
+void DynamicSSSP::edgeChanged(int u, int v) {
+    if (edgeWeight(u, v) < 0 || edgeWeight(v, u) < 0)
+        throw std::invalid_argument("DynamicSSSP: negative edge weight");
+    grow();
+    lastRepair_ = 0;
+    repair(u, v);
+    if (u != v) repair(v, u);
+}
+
+void DynamicSSSP::grow() {
+    std::size_t n = static_cast<std::size_t>(g_->V());
+    if (dist_.size() >= n) return;
+    dist_.resize(n, INF);
+    parent_.resize(n, -1);
+    inSubtree_.resize(n, 0);
+}
+
+int DynamicSSSP::edgeWeight(int u, int v) const {
+    int best = INF;
+    for (auto e : g_->neighbors(u)) {
+        if (e.to == v && e.w < best) best = e.w;
+    }
+    return best;
+}
+
+// Repair for the x->y direction of a changed edge.
+void DynamicSSSP::repair(int x, int y) {
+    int w = edgeWeight(x, y);
+    int viaX = (dist_[x] == INF || w == INF) ? INF : dist_[x] + w;
+
+    if (viaX < dist_[y]) {
+        // cheaper (or new) edge: improvements spread outward from y
+        dist_[y] = viaX;
+        parent_[y] = x;
+        push(viaX, y);
+        lastRepair_ += settle(false);
+        return;
+    }
+    if (parent_[y] != x || viaX == dist_[y]) return; // tree unaffected
+
+    // dearer or closed tree edge: detach the subtree hanging below y
+    std::vector<int> sub{y};
+    inSubtree_[y] = 1;
+    for (std::size_t i=0; i<sub.size(); i++) {
+        int a = sub[i];
+        for (auto e : g_->neighbors(a)) {
+            if (parent_[e.to] == a && !inSubtree_[e.to]) {
+                inSubtree_[e.to] = 1;
+                sub.push_back(e.to);
+            }
+        }
+    }
+    for (int a : sub) { dist_[a] = INF; parent_[a] = -1; }
+
+    // re-seed every detached node from its best unaffected neighbour
+    for (int a : sub) {
+        for (auto e : g_->neighbors(a)) {
+            int b = e.to;
+            if (inSubtree_[b] || dist_[b] == INF) continue;
+            if (dist_[b] + e.w < dist_[a]) {
+                dist_[a] = dist_[b] + e.w;
+                parent_[a] = b;
+            }
+        }
+        if (dist_[a] != INF) push(dist_[a], a);
+    }
+    settle(true);
+
+    for (int a : sub) inSubtree_[a] = 0;
+    lastRepair_ += sub.size();
+}
+
+void DynamicSSSP::push(int d, int node) {
+    heap_.push_back({d, node});
+    std::push_heap(heap_.begin(), heap_.end(), heapAfter);
+}
+
+// Dijkstra over the queued nodes; `confined` keeps it inside the detached subtree.
+std::size_t DynamicSSSP::settle(bool confined) {
+    std::size_t settled = 0;
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), heapAfter);
+        HeapItem cur = heap_.back();
+        heap_.pop_back();
+        if (cur.d != dist_[cur.node]) continue;
+        settled++;
+
+        for (auto e : g_->neighbors(cur.node)) {
+            int v = e.to;
+            if (confined && !inSubtree_[v]) continue;
+            int nd = cur.d + e.w;
+            if (nd < dist_[v]) {
+                dist_[v] = nd;
+                parent_[v] = cur.node;
+                push(nd, v);
+            }
+        }
+    }
+    return settled;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "structures/graph/Graph.hpp"
+
+// Shortest-path tree from one source that survives road updates.
+// After any add/remove/reweight of u-v edges, edgeChanged(u, v) repairs
+// only what the change can affect (Ramalingam-Reps style):
+// - cheaper edge: Dijkstra outward from the improved endpoint
+// - dearer/closed tree edge: the subtree below it is detached, re-seeded
+//   from its unaffected neighbours and settled with a Dijkstra confined
+//   to that subtree
+// Undirected graphs only (repairs look for parents among neighbours).
+class DynamicSSSP {
+public:
+    DynamicSSSP(const Graph& g, int source); // throws std::invalid_argument if g is directed
+
+    int source() const { return source_; }
+    int distance(int v) const;               // -1 if unreachable
+    std::vector<int> pathTo(int v) const;    // source..v, empty if unreachable
+
+    // Throws std::invalid_argument (tree untouched) if a u-v edge is negative.
+    void edgeChanged(int u, int v);
+    void recompute();
+
+    // Nodes whose distance was reconsidered by the last edgeChanged().
+    std::size_t lastRepairSize() const { return lastRepair_; }
+
+private:
+    struct HeapItem { int d; int node; };
+
+    const Graph* g_;
+    int source_;
+    std::vector<int> dist_;
+    std::vector<int> parent_;
+    std::vector<char> inSubtree_;
+    std::vector<HeapItem> heap_;
+    std::size_t lastRepair_{0};
+
+    void grow();
+    int edgeWeight(int u, int v) const; // cheapest u->v edge, INF if none
+    void repair(int u, int v);
+    std::size_t settle(bool confined);
+    void push(int d, int node);
+    static bool heapAfter(const HeapItem& a, const HeapItem& b) { return a.d > b.d; }
+};
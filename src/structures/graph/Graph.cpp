@@ -1,36 +1,397 @@
 #include "structures/graph/Graph.hpp"
+#include "structures/graph/GraphFile.hpp"
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
 
 Graph::Graph(bool directed) : directed_(directed), idOf_(32) {}
 
-int Graph::addNode(const std::string& name) {
-    auto id = idOf_.get(name);
+void Graph::clear() {
+    file_.reset();
+    mapped_ = false;
+    fileV_ = 0;
+    fileOff_ = nullptr;
+    fileEdges_ = nullptr;
+    idOf_.clear();
+    nameIndex_.clear();
+    frozen_ = false;
+    nameOf_.clear();
+    names_.clear();
+    adj_.clear();
+    origId_.clear();
+    coordX_.clear();
+    coordY_.clear();
+}
+
+int Graph::addNode(std::string_view name) {
+    auto id = lookup(name);
     if (id.has_value()) return *id;
+    materialize();
+    if (frozen_) thawNames();
 
     int nid = static_cast<int>(adj_.size());
-    idOf_.put(name, nid);
-    nameOf_.push_back(name);
+    std::string_view stored = names_.add(name);
+    idOf_.put(stored, nid);
+    nameOf_.push_back(stored);
     adj_.push_back({});
+    if (!origId_.empty()) origId_.push_back(nid);
+    if (!coordX_.empty()) {
+        coordX_.push_back(std::nan(""));
+        coordY_.push_back(std::nan(""));
+    }
     return nid;
 }
 
-void Graph::addEdge(const std::string& from, const std::string& to, int weight) {
+void Graph::addEdge(std::string_view from, std::string_view to, int weight) {
     int u = addNode(from);
     int v = addNode(to);
+    addEdge(u, v, weight);
+}
+
+void Graph::addEdge(int u, int v, int weight) {
+    if (u < 0 || v < 0 || u >= V() || v >= V()) throw std::out_of_range("bad node id");
+    materialize();
     adj_[u].push_back({v, weight});
     if (!directed_) adj_[v].push_back({u, weight});
 }
 
-int Graph::nodeId(const std::string& name) const {
-    return idOf_.at(name);
+bool Graph::removeEdge(std::string_view from, std::string_view to) {
+    auto u = lookup(from);
+    auto v = lookup(to);
+    return u && v && removeEdge(*u, *v);
+}
+
+bool Graph::updateWeight(std::string_view from, std::string_view to, int weight) {
+    auto u = lookup(from);
+    auto v = lookup(to);
+    return u && v && updateWeight(*u, *v, weight);
+}
+
+static bool eraseEdgesTo(std::vector<Graph::Edge>& list, int to) {
+    std::size_t before = list.size();
+    list.erase(std::remove_if(list.begin(), list.end(), [&](const Graph::Edge& e){ return e.to == to; }),
+               list.end());
+    return list.size() != before;
+}
+
+// Whether some u->v edge exists; edits that find none leave a mapped
+// graph mapped.
+static bool hasEdge(const Graph& g, int u, int v) {
+    for (auto e : g.neighbors(u)) if (e.to == v) return true;
+    return false;
+}
+
+bool Graph::removeEdge(int u, int v) {
+    if (!hasEdge(*this, u, v)) return false;
+    materialize();
+    bool found = eraseEdgesTo(adj_[u], v);
+    if (found && !directed_ && u != v) eraseEdgesTo(adj_[v], u);
+    return found;
+}
+
+bool Graph::updateWeight(int u, int v, int weight) {
+    if (!hasEdge(*this, u, v)) return false;
+    materialize();
+    bool found = false;
+    for (auto& e : adj_[u]) {
+        if (e.to == v) { e.w = weight; found = true; }
+    }
+    if (found && !directed_) {
+        for (auto& e : adj_[v]) if (e.to == u) e.w = weight;
+    }
+    return found;
+}
+
+void Graph::setCoord(int id, double x, double y) {
+    if (id < 0 || id >= V()) throw std::out_of_range("bad node id");
+    materialize();
+    if (coordX_.empty()) {
+        coordX_.assign(V(), std::nan(""));
+        coordY_.assign(V(), std::nan(""));
+    }
+    coordX_[id] = x;
+    coordY_[id] = y;
+}
+
+bool Graph::hasCoord(int id) const {
+    if (mapped_) return file_->hasCoords() && !std::isnan(file_->coordX(id));
+    return !coordX_.empty() && !std::isnan(coordX_[id]);
+}
+
+void Graph::renumber(const std::vector<int>& newId) {
+    const int n = V();
+    if ((int)newId.size() != n) throw std::invalid_argument("renumber: size mismatch");
+    std::vector<char> hit(n, 0);
+    for (int x : newId) {
+        if (x < 0 || x >= n || hit[x]) throw std::invalid_argument("renumber: not a permutation");
+        hit[x] = 1;
+    }
+    materialize();
+
+    std::vector<std::vector<Edge>> adj(n);
+    std::vector<std::string_view> names(n);
+    std::vector<int> orig(n);
+    for (int v=0; v<n; v++) {
+        int nv = newId[v];
+        adj[nv] = std::move(adj_[v]);
+        for (auto& e : adj[nv]) e.to = newId[e.to];
+        names[nv] = nameOf_[v];
+        orig[nv] = originalId(v);
+    }
+    if (!coordX_.empty()) {
+        std::vector<double> xs(n), ys(n);
+        for (int v=0; v<n; v++) { xs[newId[v]] = coordX_[v]; ys[newId[v]] = coordY_[v]; }
+        coordX_.swap(xs);
+        coordY_.swap(ys);
+    }
+    adj_.swap(adj);
+    nameOf_.swap(names);
+    origId_.swap(orig);
+    bool refreeze = frozen_;
+    if (frozen_) {
+        nameIndex_.clear();
+        frozen_ = false;
+    }
+    for (int v=0; v<n; v++) idOf_.put(nameOf_[v], v);
+    if (refreeze) freezeNames();
+}
+
+std::optional<int> Graph::lookup(std::string_view name) const {
+    if (mapped_) {
+        int id = file_->nodeId(name); // confirms the name
+        if (id < 0) return std::nullopt;
+        return id;
+    }
+    if (!frozen_) return idOf_.get(name);
+    int id = nameIndex_.find(name);
+    if (id < 0 || nameOf_[id] != name) return std::nullopt; // fingerprint false positive
+    return id;
+}
+
+int Graph::nodeId(std::string_view name) const {
+    auto id = lookup(name);
+    if (!id) throw std::out_of_range("Graph: unknown node: " + std::string(name));
+    return *id;
+}
+
+std::optional<int> Graph::nodeIdOpt(std::string_view name) const {
+    return lookup(name);
+}
+
+bool Graph::freezeNames() {
+    if (frozen_) return true;
+    if (!nameIndex_.buildFrom(idOf_)) return false;
+    idOf_.reset();
+    frozen_ = true;
+    return true;
+}
+
+void Graph::thawNames() {
+    idOf_.reserve(nameOf_.size());
+    for (std::size_t i=0; i<nameOf_.size(); i++) idOf_.put(nameOf_[i], static_cast<int>(i));
+    nameIndex_.clear();
+    frozen_ = false;
+}
+
+std::string_view Graph::nodeName(int id) const {
+    if (id < 0 || id >= V()) throw std::out_of_range("bad node id");
+    return mapped_ ? file_->nodeName(id) : nameOf_[id];
+}
+
+
+template <typename T>
+static void writeArray(std::ofstream& f, const T* p, std::size_t n) {
+    if (n) f.write(reinterpret_cast<const char*>(p), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+static void padTo8(std::ofstream& f, std::uint64_t& at, std::uint64_t bytes) {
+    static const char zeros[8] = {};
+    at += bytes;
+    std::uint64_t pad = (8 - at % 8) % 8;
+    f.write(zeros, static_cast<std::streamsize>(pad));
+    at += pad;
+}
+
+bool Graph::saveBinary(const std::string& path) const {
+    // never truncate a file that may be mapped (by this graph or another)
+    const std::string tmp = path + ".tmp";
+    bool ok = writeSnapshot(tmp);
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tmp, path, ec);
+    if (!ok || ec) { std::remove(tmp.c_str()); return false; }
+    return true;
+}
+
+bool Graph::writeSnapshot(const std::string& path) const {
+    std::ofstream f(path, std::ios::binary);
+    if (!f) return false;
+
+    const std::uint64_t n = static_cast<std::uint64_t>(V());
+    std::vector<std::uint64_t> nameOff(n + 1, 0), edgeOff(n + 1, 0);
+    for (std::uint64_t i=0; i<n; i++) {
+        nameOff[i + 1] = nameOff[i] + nodeName(static_cast<int>(i)).size();
+        edgeOff[i + 1] = edgeOff[i] + neighbors(static_cast<int>(i)).size();
+    }
+    bool coords = false, orig = false;
+    for (int i=0; i<V() && !(coords && orig); i++) {
+        coords = coords || hasCoord(i);
+        orig = orig || originalId(i) != i;
+    }
+
+    GraphFile::Header h{};
+    std::memcpy(h.magic, GraphFile::kMagic, sizeof(h.magic));
+    h.version = GraphFile::kVersion;
+    h.flags = directed_ ? GraphFile::kDirected : 0;
+    h.nodes = n;
+    h.edges = edgeOff[n];
+    h.namesBytes = nameOff[n];
+    h.nameOffsetsAt = sizeof(GraphFile::Header);
+    h.namesAt = h.nameOffsetsAt + (n + 1) * 8;
+    h.edgeOffsetsAt = (h.namesAt + h.namesBytes + 7) / 8 * 8;
+    h.edgesAt = h.edgeOffsetsAt + (n + 1) * 8;
+    std::uint64_t end = h.edgesAt + h.edges * sizeof(Edge);
+    if (coords) {
+        h.flags |= GraphFile::kHasCoords;
+        h.coordsAt = end;
+        end = h.coordsAt + n * 16;
+    }
+    if (orig) {
+        h.flags |= GraphFile::kHasOrigIds;
+        h.origIdsAt = end;
+        end = h.origIdsAt + n * 4;
+    }
+    // a snapshot's node set is fixed, so it always carries the index
+    PerfectHash built;
+    const PerfectHash* index = &nameIndex();
+    if (!frozen_) {
+        std::vector<int> ids(n);
+        for (std::uint64_t i=0; i<n; i++) ids[i] = static_cast<int>(i);
+        index = built.build(nameOf_, ids) ? &built : nullptr;
+    }
+    if (index) {
+        h.flags |= GraphFile::kHasNameIndex;
+        h.nameIndexAt = (end + 7) / 8 * 8;
+        h.nameIndexBytes = index->bytes();
+    }
+    writeArray(f, &h, 1);
+
+    std::uint64_t at = h.nameOffsetsAt;
+    writeArray(f, nameOff.data(), nameOff.size());
+    padTo8(f, at, nameOff.size() * 8);
+    for (int i=0; i<V(); i++) {
+        std::string_view name = nodeName(i);
+        writeArray(f, name.data(), name.size());
+    }
+    padTo8(f, at, h.namesBytes);
+    writeArray(f, edgeOff.data(), edgeOff.size());
+    padTo8(f, at, edgeOff.size() * 8);
+    for (int i=0; i<V(); i++) {
+        Edges list = neighbors(i);
+        writeArray(f, list.begin(), list.size());
+    }
+    padTo8(f, at, h.edges * sizeof(Edge));
+    if (coords) {
+        std::vector<double> xy(2 * n);
+        for (int i=0; i<V(); i++) {
+            xy[2 * i] = hasCoord(i) ? coordX(i) : std::nan("");
+            xy[2 * i + 1] = hasCoord(i) ? coordY(i) : std::nan("");
+        }
+        writeArray(f, xy.data(), xy.size());
+        padTo8(f, at, xy.size() * 8);
+    }
+    if (orig) {
+        std::vector<std::int32_t> ids(n);
+        for (int i=0; i<V(); i++) ids[i] = originalId(i);
+        writeArray(f, ids.data(), ids.size());
+        padTo8(f, at, ids.size() * 4);
+    }
+    if (index) index->write(f);
+    return static_cast<bool>(f);
 }
 
-std::optional<int> Graph::nodeIdOpt(const std::string& name) const {
-    return idOf_.get(name);
+bool Graph::loadBinary(const std::string& path) {
+    auto m = std::make_unique<GraphFile::Mapped>();
+    if (!m->open(path) || m->directed() != directed_ || !m->validate()) return false;
+
+    // a fresh graph first, so a bad file leaves this one as it was
+    Graph g(directed_);
+    g.fileV_ = m->V();
+    g.fileOff_ = m->edgeOffsets();
+    g.fileEdges_ = m->edges();
+    g.file_ = std::move(m);
+    g.mapped_ = true;
+    g.frozen_ = true;
+    // the stored index must agree with the names (which also rules out
+    // duplicates); one that does not load or does not agree is rebuilt
+    // from the names rather than trusted
+    const PerfectHash& index = g.file_->nameIndex();
+    bool usable = !index.empty();
+    for (int i=0; i<g.fileV_ && usable; i++) usable = index.find(g.file_->nodeName(i)) == i;
+    if (!usable && !g.materialize(false)) return false;
+    swap(g);
+    return true;
 }
 
-const std::string& Graph::nodeName(int id) const {
-    if (id < 0 || id >= (int)nameOf_.size()) throw std::out_of_range("bad node id");
-    return nameOf_[id];
+bool Graph::materialize(bool keepIndex) {
+    if (!mapped_) return true;
+    const GraphFile::Mapped& m = *file_;
+    const int n = fileV_;
+    const PerfectHash& index = m.nameIndex();
+    const bool indexed = keepIndex && !index.empty(); // checked by loadBinary
+
+    nameOf_.resize(n);
+    for (int i=0; i<n; i++) nameOf_[i] = m.nodeName(i); // stays in the mapping
+    if (indexed) {
+        nameIndex_.load(index.data(), index.bytes());
+        idOf_.reset();
+        frozen_ = true;
+    } else {
+        nameIndex_.clear();
+        frozen_ = false;
+        idOf_.reserve(n);
+        for (int i=0; i<n; i++) {
+            std::size_t before = idOf_.size();
+            idOf_.put(nameOf_[i], i);
+            if (idOf_.size() == before) return false; // duplicate name
+        }
+    }
+    adj_.resize(n);
+    for (int i=0; i<n; i++) adj_[i].assign(m.edges() + m.edgeBegin(i), m.edges() + m.edgeEnd(i));
+    if (m.hasCoords()) {
+        coordX_.resize(n);
+        coordY_.resize(n);
+        for (int i=0; i<n; i++) { coordX_[i] = m.coordX(i); coordY_[i] = m.coordY(i); }
+    }
+    if (m.hasOriginalIds()) {
+        origId_.resize(n);
+        for (int i=0; i<n; i++) origId_[i] = m.originalId(i);
+    }
+    mapped_ = false;
+    fileV_ = 0;
+    fileOff_ = nullptr;
+    fileEdges_ = nullptr;
+    if (!frozen_) freezeNames();
+    return true;
 }
 
+void Graph::swap(Graph& other) {
+    std::swap(directed_, other.directed_);
+    names_.swap(other.names_);
+    idOf_.swap(other.idOf_);
+    nameIndex_.swap(other.nameIndex_);
+    std::swap(frozen_, other.frozen_);
+    nameOf_.swap(other.nameOf_);
+    adj_.swap(other.adj_);
+    origId_.swap(other.origId_);
+    coordX_.swap(other.coordX_);
+    coordY_.swap(other.coordY_);
+    file_.swap(other.file_);
+    std::swap(mapped_, other.mapped_);
+    std::swap(fileV_, other.fileV_);
+    std::swap(fileOff_, other.fileOff_);
+    std::swap(fileEdges_, other.fileEdges_);
+}
@@ -1,31 +1,124 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
+#include <memory>
+#include <cstddef>
 #include "structures/hash/HashTable.hpp"
+#include "structures/hash/StringArena.hpp"
+#include "structures/hash/PerfectHash.hpp"
+#include "structures/graph/GraphFile.hpp"
 
 class Graph {
 public:
     explicit Graph(bool directed=false);
 
-    int addNode(const std::string& name);
-    void addEdge(const std::string& from, const std::string& to, int weight);
+    int addNode(std::string_view name);
+    void addEdge(std::string_view from, std::string_view to, int weight);
+    void addEdge(int u, int v, int weight); // both ids must exist
 
-    int nodeId(const std::string& name) const;                 // throws if missing
-    std::optional<int> nodeIdOpt(const std::string& name) const;
-    const std::string& nodeName(int id) const;
+    // Road closures / traffic updates. Both act on every from->to edge
+    // (and the mirrored edges when undirected); false if there was none.
+    bool removeEdge(std::string_view from, std::string_view to);
+    bool updateWeight(std::string_view from, std::string_view to, int weight);
+    bool removeEdge(int u, int v);
+    bool updateWeight(int u, int v, int weight);
+
+    int nodeId(std::string_view name) const;            // throws if missing
+    std::optional<int> nodeIdOpt(std::string_view name) const;
+    // Drops every node and edge; directedness stays.
+    void clear();
+    std::string_view nodeName(int id) const;            // stays valid until loadBinary() / clear()
+
+    // Once the node set stops changing: swap the name -> id hash table for
+    // a minimal perfect hash (a few bits per name; hits are confirmed
+    // against the stored name). addNode() of a new name thaws it again.
+    // loadBinary() of a file with a name index comes back frozen.
+    bool freezeNames();
+    bool namesFrozen() const { return frozen_; }
+    const PerfectHash& nameIndex() const { return mapped_ ? file_->nameIndex() : nameIndex_; }
+
+    // Optional planar coordinates (projected x/y, or lon/lat over a city).
+    void setCoord(int id, double x, double y);
+    bool hasCoord(int id) const;
+    double coordX(int id) const { return mapped_ ? file_->coordX(id) : coordX_[id]; } // only if hasCoord(id)
+    double coordY(int id) const { return mapped_ ? file_->coordY(id) : coordY_[id]; }
+
+    // Node v becomes node newId[v] (newId must be a permutation of
+    // 0..V-1); adjacency, names, coordinates and the name index move together.
+    void renumber(const std::vector<int>& newId);
+    // Id the node had before any renumber() (insertion order); binary
+    // snapshots keep it.
+    int originalId(int id) const {
+        if (mapped_) return file_->hasOriginalIds() ? file_->originalId(id) : id;
+        return origId_.empty() ? id : origId_[id];
+    }
+
+    // Binary snapshot (format in GraphFile.hpp). saveBinary writes a
+    // temporary file and renames it over path. loadBinary replaces the
+    // whole graph; the file must match directed(). false (and the graph
+    // unchanged) on I/O or format errors.
+    // A loaded graph reads adjacency, names, coordinates and the name
+    // index straight from the mapped file: loading costs one read-only
+    // validation pass, not a copy. The first edit (addNode of a new name,
+    // any edge change, setCoord, renumber) copies the adjacency out; names
+    // keep pointing into the mapping, which stays open until the next
+    // loadBinary() or clear().
+    bool saveBinary(const std::string& path) const;
+    bool loadBinary(const std::string& path);
 
     bool directed() const { return directed_; }
-    int V() const { return static_cast<int>(adj_.size()); }
+    int V() const { return mapped_ ? fileV_ : static_cast<int>(adj_.size()); }
+
+    using Edge = GraphFile::Edge; // { to, w }
 
-    struct Edge { int to; int w; };
+    // One adjacency list, from the graph's own storage or the mapped file.
+    class Edges {
+    public:
+        Edges(const Edge* first, const Edge* last) : first_(first), last_(last) {}
+        const Edge* begin() const { return first_; }
+        const Edge* end() const { return last_; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        bool empty() const { return first_ == last_; }
+        const Edge& operator[](std::size_t i) const { return first_[i]; }
+    private:
+        const Edge* first_;
+        const Edge* last_;
+    };
 
-    const std::vector<Edge>& neighbors(int id) const { return adj_[id]; }
+    Edges neighbors(int id) const {
+        if (mapped_) return {fileEdges_ + fileOff_[id], fileEdges_ + fileOff_[id + 1]};
+        const auto& list = adj_[id];
+        return {list.data(), list.data() + list.size()};
+    }
 
 private:
     bool directed_;
-    HashTable<int> idOf_;                // node name -> id
-    std::vector<std::string> nameOf_;    // id -> name
-    std::vector<std::vector<Edge>> adj_; // adjacency list
+    StringArena names_;                     // every node name, stored once
+    HashTable<int, std::string_view> idOf_; // node name -> id (keys point into names_), empty while frozen
+    PerfectHash nameIndex_;                 // node name -> id while frozen
+    bool frozen_{false};
+    std::vector<std::string_view> nameOf_;  // id -> name (points into names_)
+    std::vector<std::vector<Edge>> adj_;    // adjacency list
+    std::vector<int> origId_;               // id -> insertion-order id (empty = identity)
+    std::vector<double> coordX_, coordY_;   // NaN = unknown; empty until the first setCoord()
+
+    // Snapshot from loadBinary(). While mapped_, everything above except
+    // directed_ is unused and reads go to the file (frozen_ stays true).
+    std::unique_ptr<GraphFile::Mapped> file_;
+    bool mapped_{false};
+    int fileV_{0};
+    const std::uint64_t* fileOff_{nullptr};
+    const Edge* fileEdges_{nullptr};
+
+    std::optional<int> lookup(std::string_view name) const;
+    void swap(Graph& other);
+    void thawNames();
+    // Copies the mapped snapshot into the graph's own storage (no-op when
+    // not mapped). Without a usable name index the names are hashed here;
+    // false on a duplicate name.
+    bool materialize(bool keepIndex = true);
+    bool writeSnapshot(const std::string& path) const;
 };
 
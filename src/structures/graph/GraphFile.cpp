@@ -0,0 +1,114 @@
+#include "structures/graph/GraphFile.hpp"
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GraphFile {
+
+static bool sectionFits(std::uint64_t at, std::uint64_t bytes, std::size_t fileSize) {
+    return at % 8 == 0 && at <= fileSize && bytes <= fileSize - at;
+}
+
+bool Mapped::open(const std::string& path) {
+    close();
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) { ::close(fd); return false; }
+    void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    base_ = static_cast<const unsigned char*>(p);
+    size_ = static_cast<std::size_t>(st.st_size);
+#else
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) return false;
+    fallback_.resize(static_cast<std::size_t>(f.tellg()));
+    f.seekg(0);
+    if (fallback_.size() < sizeof(Header) ||
+        !f.read(reinterpret_cast<char*>(fallback_.data()), fallback_.size())) {
+        fallback_.clear();
+        return false;
+    }
+    base_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+
+    hdr_ = reinterpret_cast<const Header*>(base_);
+    const std::uint64_t n = hdr_->nodes, m = hdr_->edges;
+    bool ok = std::memcmp(hdr_->magic, kMagic, sizeof(kMagic)) == 0
+        && hdr_->version == kVersion
+        && n < (1ULL << 31) && m < (1ULL << 40)
+        && sectionFits(hdr_->nameOffsetsAt, (n + 1) * 8, size_)
+        && sectionFits(hdr_->namesAt, hdr_->namesBytes, size_)
+        && sectionFits(hdr_->edgeOffsetsAt, (n + 1) * 8, size_)
+        && sectionFits(hdr_->edgesAt, m * sizeof(Edge), size_)
+        && (!(hdr_->flags & kHasCoords) || sectionFits(hdr_->coordsAt, n * 16, size_))
+        && (!(hdr_->flags & kHasOrigIds) || sectionFits(hdr_->origIdsAt, n * 4, size_))
+        && (!(hdr_->flags & kHasNameIndex) || sectionFits(hdr_->nameIndexAt, hdr_->nameIndexBytes, size_));
+    if (ok) {
+        nameOff_ = reinterpret_cast<const std::uint64_t*>(base_ + hdr_->nameOffsetsAt);
+        names_ = reinterpret_cast<const char*>(base_ + hdr_->namesAt);
+        edgeOff_ = reinterpret_cast<const std::uint64_t*>(base_ + hdr_->edgeOffsetsAt);
+        edges_ = reinterpret_cast<const Edge*>(base_ + hdr_->edgesAt);
+        if (hdr_->flags & kHasCoords) coords_ = reinterpret_cast<const double*>(base_ + hdr_->coordsAt);
+        if (hdr_->flags & kHasOrigIds) origIds_ = reinterpret_cast<const std::int32_t*>(base_ + hdr_->origIdsAt);
+        ok = nameOff_[n] == hdr_->namesBytes && edgeOff_[n] == m;
+        // an index from another PerfectHash version (or hash) is just not
+        // used; the rest of the file is still fine
+        if (ok && (hdr_->flags & kHasNameIndex)) {
+            if (!nameIndex_.attach(base_ + hdr_->nameIndexAt, hdr_->nameIndexBytes) || nameIndex_.size() != n)
+                nameIndex_.clear();
+        }
+    }
+    if (!ok) close();
+    return ok;
+}
+
+bool Mapped::validate() const {
+    const int n = V();
+    for (int i=0; i<n; i++) if (!nodeInBounds(i)) return false;
+    for (std::uint64_t k=0; k<hdr_->edges; k++) {
+        if (edges_[k].to < 0 || edges_[k].to >= n) return false;
+    }
+    if (origIds_) { // a permutation, as Graph::renumber() keeps it
+        std::vector<char> seen(n, 0);
+        for (int i=0; i<n; i++) {
+            int o = origIds_[i];
+            if (o < 0 || o >= n || seen[o]) return false;
+            seen[o] = 1;
+        }
+    }
+    return true;
+}
+
+int Mapped::nodeId(std::string_view name) const {
+    int id = nameIndex_.find(name);
+    if (id < 0 || id >= V() || !nodeInBounds(id) || nodeName(id) != name) return -1;
+    return id;
+}
+
+void Mapped::close() {
+    if (!base_) return;
+#if !defined(_WIN32)
+    munmap(const_cast<unsigned char*>(base_), size_);
+#else
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+#endif
+    nameIndex_.clear();
+    base_ = nullptr;
+    size_ = 0;
+    hdr_ = nullptr;
+    coords_ = nullptr;
+    origIds_ = nullptr;
+}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "structures/hash/PerfectHash.hpp"
+
+// Binary road-network file: a fixed header followed by 8-byte aligned
+// sections (native little-endian):
+//   nameOffsets[V+1] u64 | names (bytes) | edgeOffsets[V+1] u64 |
+//   edges[E] (i32 target, i32 weight) | [coords[V] (x, y) f64 pairs] |
+//   [original ids[V] i32] | [name index: PerfectHash blob, name -> id]
+// E counts adjacency entries, so undirected edges appear in both lists.
+// Opening maps the file read-only; nothing is parsed or copied, and with
+// a name index nodeId() works straight off the mapping. The edge pairs
+// have Graph's own Edge layout, so a Graph can serve its adjacency
+// lists from the mapping as they are.
+namespace GraphFile {
+    const char kMagic[8] = {'A','C','G','R','A','P','H','\0'};
+    const std::uint32_t kVersion = 3; // 2: original-id section, 3: interleaved edges
+    const std::uint32_t kDirected = 1u << 0;  // header flags
+    const std::uint32_t kHasCoords = 1u << 1; // coordsAt is set (NaN = unknown node)
+    const std::uint32_t kHasNameIndex = 1u << 2; // nameIndexAt/nameIndexBytes are set
+    const std::uint32_t kHasOrigIds = 1u << 3;   // origIdsAt is set (after Graph::renumber)
+
+    struct Edge { std::int32_t to; std::int32_t w; };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint64_t nodes;
+        std::uint64_t edges;
+        std::uint64_t namesBytes;
+        // absolute byte offsets of the sections; 0 = section absent
+        std::uint64_t nameOffsetsAt;
+        std::uint64_t namesAt;
+        std::uint64_t edgeOffsetsAt;
+        std::uint64_t edgesAt;
+        std::uint64_t coordsAt;
+        std::uint64_t nameIndexAt;    // 0 in files written before the index existed
+        std::uint64_t nameIndexBytes;
+        std::uint64_t origIdsAt;
+    };
+
+    class Mapped {
+    public:
+        Mapped() = default;
+        ~Mapped() { close(); }
+        Mapped(const Mapped&) = delete;
+        Mapped& operator=(const Mapped&) = delete;
+
+        bool open(const std::string& path); // false if missing or malformed
+        void close();
+        bool isOpen() const { return base_ != nullptr; }
+
+        bool directed() const { return (hdr_->flags & kDirected) != 0; }
+        int V() const { return static_cast<int>(hdr_->nodes); }
+        std::uint64_t edgeCount() const { return hdr_->edges; }
+        std::uint64_t nameBytes() const { return hdr_->namesBytes; }
+
+        // open() only checks section bounds and totals. validate() also
+        // checks every node's offsets, every edge target and that original
+        // ids form a permutation (one read-only pass over those sections);
+        // nodeInBounds() is the per-node part.
+        bool validate() const;
+        bool nodeInBounds(int id) const {
+            return nameOff_[id] <= nameOff_[id + 1] && nameOff_[id + 1] <= hdr_->namesBytes
+                && edgeOff_[id] <= edgeOff_[id + 1] && edgeOff_[id + 1] <= hdr_->edges;
+        }
+
+        std::string_view nodeName(int id) const {
+            return std::string_view(names_ + nameOff_[id], nameOff_[id + 1] - nameOff_[id]);
+        }
+
+        // adjacency of id is [edgeBegin(id), edgeEnd(id)) into edges()
+        std::uint64_t edgeBegin(int id) const { return edgeOff_[id]; }
+        std::uint64_t edgeEnd(int id) const { return edgeOff_[id + 1]; }
+        const std::uint64_t* edgeOffsets() const { return edgeOff_; }
+        const Edge* edges() const { return edges_; }
+
+        bool hasCoords() const { return coords_ != nullptr; }
+        double coordX(int id) const { return coords_[2 * id]; }
+        double coordY(int id) const { return coords_[2 * id + 1]; }
+
+        // Insertion-order id of each node (a permutation, see validate()).
+        bool hasOriginalIds() const { return origIds_ != nullptr; }
+        int originalId(int id) const { return origIds_[id]; }
+
+        // Name lookup through the stored perfect hash; -1 if the name is
+        // unknown or the file has no usable index (nameIndex() empty).
+        bool hasNameIndex() const { return (hdr_->flags & kHasNameIndex) != 0; }
+        const PerfectHash& nameIndex() const { return nameIndex_; }
+        int nodeId(std::string_view name) const;
+
+    private:
+        const unsigned char* base_{nullptr};
+        std::size_t size_{0};
+        std::vector<unsigned char> fallback_; // platforms without mmap
+
+        const Header* hdr_{nullptr};
+        const std::uint64_t* nameOff_{nullptr};
+        const char* names_{nullptr};
+        const std::uint64_t* edgeOff_{nullptr};
+        const Edge* edges_{nullptr};
+        const double* coords_{nullptr};
+        const std::int32_t* origIds_{nullptr};
+        PerfectHash nameIndex_; // attached to the mapping
+    };
+}
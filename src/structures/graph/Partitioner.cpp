@@ -0,0 +1,85 @@
+#include "structures/graph/Partitioner.hpp"
+
+namespace Partitioner {
+
+struct Scratch {
+    std::vector<int> inSet;  // stamp of the node's current subset
+    std::vector<int> seen;   // stamp of the last BFS that reached it
+    int stamp{0};
+};
+
+// BFS order over `nodes` (edges leaving the subset are ignored), restarting
+// from unvisited nodes so disconnected pieces are covered too.
+static std::vector<int> bfsOrder(const Graph& g, const std::vector<int>& nodes, int root,
+                                 int setStamp, Scratch& s) {
+    int bfsStamp = ++s.stamp;
+    std::vector<int> order;
+    order.reserve(nodes.size());
+    std::size_t next = 0;
+    for (int seed = root;;) {
+        s.seen[seed] = bfsStamp;
+        order.push_back(seed);
+        for (std::size_t head = order.size() - 1; head < order.size(); head++) {
+            for (auto e : g.neighbors(order[head])) {
+                if (s.inSet[e.to] != setStamp || s.seen[e.to] == bfsStamp) continue;
+                s.seen[e.to] = bfsStamp;
+                order.push_back(e.to);
+            }
+        }
+        while (next < nodes.size() && s.seen[nodes[next]] == bfsStamp) next++;
+        if (next == nodes.size()) break;
+        seed = nodes[next];
+    }
+    return order;
+}
+
+static void split(const Graph& g, std::vector<int>& nodes, int parts, int firstPart,
+                  Result& res, Scratch& s) {
+    if (parts <= 1 || nodes.size() <= 1) {
+        for (int v : nodes) res.partOf[v] = firstPart;
+        return;
+    }
+    int setStamp = ++s.stamp;
+    for (int v : nodes) s.inSet[v] = setStamp;
+
+    // one sweep to find a far-away start, then grow the left half from it
+    int far = bfsOrder(g, nodes, nodes[0], setStamp, s).back();
+    std::vector<int> order = bfsOrder(g, nodes, far, setStamp, s);
+
+    int leftParts = parts / 2;
+    std::size_t leftSize = nodes.size() * leftParts / parts;
+    std::vector<int> left(order.begin(), order.begin() + leftSize);
+    std::vector<int> right(order.begin() + leftSize, order.end());
+    nodes.clear();
+    nodes.shrink_to_fit();
+
+    split(g, left, leftParts, firstPart, res, s);
+    split(g, right, parts - leftParts, firstPart + leftParts, res, s);
+}
+
+Result bisect(const Graph& g, int parts) {
+    Result res;
+    res.parts = parts < 1 ? 1 : parts;
+    res.partOf.assign(g.V(), 0);
+
+    Scratch s;
+    s.inSet.assign(g.V(), 0);
+    s.seen.assign(g.V(), 0);
+    std::vector<int> all(g.V());
+    for (int v=0; v<g.V(); v++) all[v] = v;
+    split(g, all, res.parts, 0, res, s);
+
+    for (int u=0; u<g.V(); u++) {
+        bool onBoundary = false;
+        for (auto e : g.neighbors(u)) {
+            if (res.partOf[e.to] == res.partOf[u]) continue;
+            onBoundary = true;
+            res.cutEdges++;
+        }
+        if (onBoundary) res.boundary.push_back(u);
+    }
+    if (!g.directed()) res.cutEdges /= 2;
+    return res;
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <vector>
+#include "structures/graph/Graph.hpp"
+
+// Splits a graph into k balanced regions with few cut edges by recursive
+// BFS bisection: each split grows one half as a BFS ball from a
+// pseudo-peripheral node, so regions stay contiguous on road networks.
+namespace Partitioner {
+    struct Result {
+        int parts{0};
+        std::vector<int> partOf;  // node -> region
+        long long cutEdges{0};    // edges whose endpoints lie in different regions
+        std::vector<int> boundary; // nodes with at least one cut edge, ascending
+    };
+
+    Result bisect(const Graph& g, int parts);
+}
@@ -0,0 +1,21 @@
+#include "structures/graph/SearchWorkspace.hpp"
+
+void SearchWorkspace::begin(int n) {
+    if ((int)seen_.size() < n) {
+        seen_.resize(n, 0);
+        done_.resize(n, 0);
+        dist_.resize(n);
+        parent_.resize(n);
+    }
+    if (++gen_ == 0) { // wrapped: old stamps could alias, wipe once
+        std::fill(seen_.begin(), seen_.end(), 0);
+        std::fill(done_.begin(), done_.end(), 0);
+        gen_ = 1;
+    }
+    heap_.clear();
+}
+
+SearchWorkspace& SearchWorkspace::local() {
+    thread_local SearchWorkspace ws;
+    return ws;
+}
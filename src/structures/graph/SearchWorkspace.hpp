@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+// Per-query scratch state for graph searches (dist / parent / done marks
+// and a binary heap) that is reused across queries instead of reallocated.
+// Every per-node slot carries the generation that wrote it, so begin()
+// "clears" all of them in O(1); a query only touches the nodes it visits.
+// Not thread-safe: use one workspace per thread (local() hands out one).
+class SearchWorkspace {
+public:
+    static const int INF = std::numeric_limits<int>::max() / 4;
+    struct HeapItem { int d; int node; };
+
+    // Start a new query over a graph with n nodes.
+    void begin(int n);
+
+    bool reached(int v) const { return seen_[v] == gen_; }
+    int dist(int v) const { return reached(v) ? dist_[v] : INF; }
+    int parent(int v) const { return reached(v) ? parent_[v] : -1; }
+    void set(int v, int d, int p) { seen_[v] = gen_; dist_[v] = d; parent_[v] = p; }
+
+    // Second independent mark (settled / in tree / visited).
+    bool done(int v) const { return done_[v] == gen_; }
+    void markDone(int v) { done_[v] = gen_; }
+
+    // Min-heap on d, emptied by begin().
+    bool heapEmpty() const { return heap_.empty(); }
+    void push(int d, int node) {
+        heap_.push_back({d, node});
+        std::push_heap(heap_.begin(), heap_.end(), after);
+    }
+    HeapItem pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), after);
+        HeapItem top = heap_.back();
+        heap_.pop_back();
+        return top;
+    }
+
+    // The calling thread's workspace.
+    static SearchWorkspace& local();
+
+private:
+    std::uint32_t gen_{0};
+    std::vector<std::uint32_t> seen_, done_;
+    std::vector<int> dist_, parent_;
+    std::vector<HeapItem> heap_;
+
+    static bool after(const HeapItem& a, const HeapItem& b) { return a.d > b.d; }
+};
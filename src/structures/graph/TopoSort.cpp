@@ -1,5 +1,7 @@
 #include "structures/graph/TopoSort.hpp"
 #include <queue>
+#include <algorithm>
+#include <stdexcept>
 
 namespace TopoSort {
 
@@ -25,5 +27,123 @@ Result kahn(const Graph& g) {
     return res;
 }
 
+Online::Online(Graph& g) : g_(g) {
+    if (!g.directed()) throw std::invalid_argument("TopoSort::Online: graph must be directed");
+    auto res = kahn(g);
+    if (!res.isDAG) throw std::invalid_argument("TopoSort::Online: graph has a cycle");
+    at_ = std::move(res.order);
+    ord_.assign(g.V(), 0);
+    for (int i=0; i<g.V(); i++) ord_[at_[i]] = i;
+    in_.assign(g.V(), {});
+    for (int u=0; u<g.V(); u++) {
+        for (auto e : g.neighbors(u)) in_[e.to].push_back(u);
+    }
+    seen_.assign(g.V(), 0);
+    from_.assign(g.V(), -1);
+}
+
+void Online::grow() {
+    // new nodes have no edges yet: they go last
+    while ((int)ord_.size() < g_.V()) {
+        int v = static_cast<int>(ord_.size());
+        ord_.push_back(v);
+        at_.push_back(v);
+        in_.push_back({});
+        seen_.push_back(0);
+        from_.push_back(-1);
+    }
+}
+
+int Online::addNode(std::string_view name) {
+    int id = g_.addNode(name);
+    grow();
+    return id;
+}
+
+bool Online::addEdge(std::string_view from, std::string_view to, int weight) {
+    int u = addNode(from);
+    int v = addNode(to);
+    return addEdge(u, v, weight);
+}
+
+bool Online::addEdge(int u, int v, int weight) {
+    if (u < 0 || v < 0 || u >= g_.V() || v >= g_.V()) throw std::out_of_range("bad node id");
+    grow();
+    cycle_.clear();
+    lastReordered_ = 0;
+    if (u == v) { cycle_.push_back(u); return false; }
+
+    int lb = ord_[v], ub = ord_[u];
+    if (lb < ub) {
+        // v currently precedes u: look at the affected region [lb, ub] only
+        if (++gen_ == 0) { std::fill(seen_.begin(), seen_.end(), 0); gen_ = 1; }
+        if (!forward(v, u, ub)) return false;
+        backward(u, lb);
+        reorder();
+    }
+    g_.addEdge(u, v, weight);
+    in_[v].push_back(u);
+    return true;
 }
 
+// Nodes reachable from v with position < ub; false if u is among them.
+bool Online::forward(int v, int u, int ub) {
+    fwd_.clear();
+    stack_.assign(1, v);
+    seen_[v] = gen_;
+    from_[v] = -1;
+    while (!stack_.empty()) {
+        int x = stack_.back(); stack_.pop_back();
+        fwd_.push_back(x);
+        for (auto e : g_.neighbors(x)) {
+            int y = e.to;
+            if (y == u) {
+                for (int w=x; w!=-1; w=from_[w]) cycle_.push_back(w);
+                std::reverse(cycle_.begin(), cycle_.end());
+                cycle_.push_back(u);
+                return false;
+            }
+            if (seen_[y] == gen_ || ord_[y] > ub) continue;
+            seen_[y] = gen_;
+            from_[y] = x;
+            stack_.push_back(y);
+        }
+    }
+    return true;
+}
+
+// Nodes that reach u with position > lb.
+void Online::backward(int u, int lb) {
+    back_.clear();
+    stack_.assign(1, u);
+    seen_[u] = gen_;
+    while (!stack_.empty()) {
+        int x = stack_.back(); stack_.pop_back();
+        back_.push_back(x);
+        for (int y : in_[x]) {
+            if (seen_[y] == gen_ || ord_[y] < lb) continue;
+            seen_[y] = gen_;
+            stack_.push_back(y);
+        }
+    }
+}
+
+// Predecessors of u keep their relative order and move in front of the
+// successors of v, reusing exactly the positions both sets occupied.
+void Online::reorder() {
+    auto byPos = [&](int a, int b) { return ord_[a] < ord_[b]; };
+    std::sort(back_.begin(), back_.end(), byPos);
+    std::sort(fwd_.begin(), fwd_.end(), byPos);
+
+    slots_.clear();
+    for (int x : back_) slots_.push_back(ord_[x]);
+    for (int x : fwd_) slots_.push_back(ord_[x]);
+    std::sort(slots_.begin(), slots_.end());
+
+    std::size_t i = 0;
+    for (int x : back_) { ord_[x] = slots_[i]; at_[slots_[i++]] = x; }
+    for (int x : fwd_) { ord_[x] = slots_[i]; at_[slots_[i++]] = x; }
+    lastReordered_ = slots_.size();
+}
+
+}
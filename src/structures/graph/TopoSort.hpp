@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <string_view>
+#include <cstdint>
 #include "structures/graph/Graph.hpp"
 
 namespace TopoSort {
@@ -9,5 +11,43 @@ namespace TopoSort {
     };
 
     Result kahn(const Graph& g);
-}
 
+    // Topological order kept up to date while edges arrive one at a time
+    // (Pearce-Kelly). An insertion only searches / reorders the nodes whose
+    // positions lie between the two endpoints, and an edge that would close
+    // a cycle is refused before it reaches the graph.
+    // All edges must be added through this object once it is attached.
+    class Online {
+    public:
+        // g must be directed and acyclic (throws std::invalid_argument).
+        explicit Online(Graph& g);
+
+        int addNode(std::string_view name);
+        // false (graph unchanged) if from->to would create a cycle;
+        // rejectedCycle() then holds to -> ... -> from.
+        bool addEdge(std::string_view from, std::string_view to, int weight = 1);
+        bool addEdge(int u, int v, int weight = 1);
+
+        const std::vector<int>& order() const { return at_; } // node ids, sources first
+        int position(int v) const { return ord_[v]; }
+        const std::vector<int>& rejectedCycle() const { return cycle_; }
+        std::size_t lastReordered() const { return lastReordered_; } // nodes moved by the last insert
+
+    private:
+        Graph& g_;
+        std::vector<int> ord_;              // node -> position
+        std::vector<int> at_;               // position -> node
+        std::vector<std::vector<int>> in_;  // predecessors (Graph keeps out-edges only)
+        std::vector<std::uint32_t> seen_;   // == gen_ when visited by the current insert
+        std::vector<int> from_;             // forward-search parent, for the cycle report
+        std::uint32_t gen_{0};
+        std::vector<int> fwd_, back_, stack_, slots_;
+        std::vector<int> cycle_;
+        std::size_t lastReordered_{0};
+
+        void grow();
+        bool forward(int v, int u, int ub);
+        void backward(int u, int lb);
+        void reorder();
+    };
+}
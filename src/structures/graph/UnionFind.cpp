@@ -0,0 +1,33 @@
+#include "structures/graph/UnionFind.hpp"
+#include <utility>
+
+UnionFind::UnionFind(int n) { reset(n); }
+
+void UnionFind::reset(int n) {
+    parent_.resize(n);
+    for (int i=0;i<n;i++) parent_[i] = i;
+    rank_.assign(n, 0);
+    sets_ = n;
+}
+
+int UnionFind::find(int x) {
+    int root = x;
+    while (parent_[root] != root) root = parent_[root];
+    while (parent_[x] != root) {
+        int nxt = parent_[x];
+        parent_[x] = root;
+        x = nxt;
+    }
+    return root;
+}
+
+bool UnionFind::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (rank_[a] < rank_[b]) std::swap(a, b);
+    parent_[b] = a;
+    if (rank_[a] == rank_[b]) rank_[a]++;
+    sets_--;
+    return true;
+}
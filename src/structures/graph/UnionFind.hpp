@@ -0,0 +1,19 @@
+#pragma once
+#include <vector>
+
+// Disjoint sets with union by rank and path compression (iterative, so
+// long parent chains never recurse).
+class UnionFind {
+public:
+    explicit UnionFind(int n = 0);
+
+    void reset(int n);
+    int find(int x);
+    bool unite(int a, int b); // false if already in the same set
+    int sets() const { return sets_; }
+
+private:
+    std::vector<int> parent_;
+    std::vector<unsigned char> rank_;
+    int sets_{0};
+};
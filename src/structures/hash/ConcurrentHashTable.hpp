@@ -0,0 +1,92 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <vector>
+#include "structures/hash/HashTable.hpp"
+
+// Thread-safe string-keyed table: N lock-striped shards, each a HashTable
+// behind its own reader/writer lock.
+// - the key's hash picks the shard (bits the shard's table does not use
+//   for probing) and is reused inside it
+// - lookups on different shards never contend; lookups on one shard share
+//   its lock, writes take it exclusively
+// - no at(): a reference into a shard would outlive the lock
+
+template <typename V, typename K = std::string, typename Hash = HashUtils::WordHash>
+class ConcurrentHashTable {
+public:
+    explicit ConcurrentHashTable(std::size_t shards = 64, std::size_t initial_capacity = 16)
+        : mask_(HashUtils::nextPow2(shards) - 1) {
+        std::size_t perShard = initial_capacity / (mask_ + 1) + 1;
+        for (std::size_t i=0; i<=mask_; i++) shards_.push_back(std::make_unique<Shard>(perShard));
+    }
+
+    bool contains(const K& key) const {
+        std::uint64_t h = Hash{}(key);
+        const Shard& s = shardFor(h);
+        std::shared_lock<std::shared_mutex> lk(s.m);
+        return s.table.find(key, h) != nullptr;
+    }
+
+    // Insert or overwrite
+    void put(const K& key, const V& value) {
+        std::uint64_t h = Hash{}(key);
+        Shard& s = shardFor(h);
+        std::unique_lock<std::shared_mutex> lk(s.m);
+        s.table.putHashed(key, value, h);
+    }
+
+    // Returns std::optional<V> (copy)
+    std::optional<V> get(const K& key) const {
+        std::uint64_t h = Hash{}(key);
+        const Shard& s = shardFor(h);
+        std::shared_lock<std::shared_mutex> lk(s.m);
+        auto* slot = s.table.find(key, h);
+        if (!slot) return std::nullopt;
+        return slot->value;
+    }
+
+    bool erase(const K& key) {
+        std::uint64_t h = Hash{}(key);
+        Shard& s = shardFor(h);
+        std::unique_lock<std::shared_mutex> lk(s.m);
+        return s.table.eraseHashed(key, h);
+    }
+
+    // Sum over shards; only exact while no writer is running.
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (const auto& s : shards_) {
+            std::shared_lock<std::shared_mutex> lk(s->m);
+            n += s->table.size();
+        }
+        return n;
+    }
+
+    std::size_t shardCount() const { return shards_.size(); }
+
+    void clear() {
+        for (auto& s : shards_) {
+            std::unique_lock<std::shared_mutex> lk(s->m);
+            s->table.clear();
+        }
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+private:
+    struct alignas(64) Shard { // own cache line(s): no false sharing between locks
+        explicit Shard(std::size_t capacity) : table(capacity) {}
+        mutable std::shared_mutex m;
+        HashTable<V, K, Hash> table;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t mask_;
+
+    // bits 32..: HashTable probes with the low bits and tags with the top 7
+    Shard& shardFor(std::uint64_t h) const { return *shards_[(h >> 32) & mask_]; }
+};
@@ -1,141 +1,319 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <utility>
+#include <algorithm>
+#include <memory>
+#include <new>
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include "structures/hash/HashUtils.hpp"
 
-// Custom hash table for string keys using separate chaining.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ALGOCITY_HASH_SSE2 1
+#endif
+
+// Custom hash table for string keys, open addressing (Swiss-table style).
 // - No std::unordered_map
-// - resize() doubles capacity when load factor > 0.7
+// - keys, values and their full hashes live inline in one flat slot
+//   array; a parallel array of 1-byte control codes (empty / deleted /
+//   7-bit hash fingerprint) is probed 16 slots at a time (SSE2, scalar
+//   fallback elsewhere)
+// - grows (doubles) once live + deleted slots would exceed 7/8 of capacity,
+//   incrementally: the old array stays live and every put/erase moves a
+//   few groups across, so no single insert pays for the whole table.
+//   Stored hashes mean keys are never rehashed. reserve() presizes.
+// - K = std::string owns its keys; K = std::string_view stores views the
+//   caller keeps alive (Graph points them into its name arena)
+// - Hash maps a std::string_view to 64 bits (HashUtils::WordHash by
+//   default, HashUtils::Fnv1a for the old behaviour)
+// - not synchronized; const members may run concurrently while nobody
+//   writes (see ConcurrentHashTable for shared read/write use)
 
-template <typename V>
+template <typename V, typename K = std::string, typename Hash = HashUtils::WordHash>
 class HashTable {
 public:
-    HashTable(std::size_t initial_capacity = 16)
-        : buckets_(HashUtils::nextPow2(initial_capacity)), size_(0) {}
+    HashTable(std::size_t initial_capacity = 16) { cur_.allocate(slotsFor(initial_capacity)); }
 
-    bool contains(const std::string& key) const {
-        return findNode(key) != nullptr;
+    bool contains(const K& key) const {
+        return find(key, Hash{}(key)) != nullptr;
     }
 
     // Insert or overwrite
-    void put(const std::string& key, const V& value) {
-        maybeResize();
-        std::size_t idx = indexFor(key);
-        Node* cur = buckets_[idx];
-        while (cur) {
-            if (cur->key == key) { cur->value = value; return; }
-            cur = cur->next;
-        }
-        buckets_[idx] = new Node{key, value, buckets_[idx]};
-        ++size_;
-    }
+    void put(const K& key, const V& value) { putHashed(key, value, Hash{}(key)); }
 
     // Returns std::optional<V> (copy)
-    std::optional<V> get(const std::string& key) const {
-        Node* n = findNode(key);
-        if (!n) return std::nullopt;
-        return n->value;
+    std::optional<V> get(const K& key) const {
+        const Slot* s = find(key, Hash{}(key));
+        if (!s) return std::nullopt;
+        return s->value;
     }
 
     // Like get(), but throws if missing (convenient in algorithms)
-    const V& at(const std::string& key) const {
-        Node* n = findNode(key);
-        if (!n) throw std::out_of_range("HashTable: key not found: " + key);
-        return n->value;
-    }
-
-    bool erase(const std::string& key) {
-        std::size_t idx = indexFor(key);
-        Node* cur = buckets_[idx];
-        Node* prev = nullptr;
-        while (cur) {
-            if (cur->key == key) {
-                if (prev) prev->next = cur->next;
-                else buckets_[idx] = cur->next;
-                delete cur;
-                --size_;
-                return true;
+    const V& at(const K& key) const {
+        const Slot* s = find(key, Hash{}(key));
+        if (!s) throw std::out_of_range("HashTable: key not found: " + std::string(key));
+        return s->value;
+    }
+
+    bool erase(const K& key) { return eraseHashed(key, Hash{}(key)); }
+
+    void swap(HashTable& other) {
+        std::swap(cur_, other.cur_);
+        std::swap(old_, other.old_);
+        std::swap(migrated_, other.migrated_);
+        std::swap(size_, other.size_);
+    }
+
+    // Make room for n entries without any further resize.
+    void reserve(std::size_t n) {
+        finishMigration();
+        std::size_t need = slotsFor(n + n / 7 + 1);
+        if (need <= cur_.cap) return;
+        startResize(need);
+        finishMigration();
+    }
+
+    // fn(key, value) for every entry, in no particular order.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Table* t : {&cur_, &old_}) {
+            for (std::size_t i=0; i<t->cap; i++) {
+                if (t->ctrl[i] >= 0) fn(t->slots[i].key, t->slots[i].value);
             }
-            prev = cur;
-            cur = cur->next;
         }
-        return false;
     }
 
     std::size_t size() const { return size_; }
-    std::size_t capacity() const { return buckets_.size(); }
+    std::size_t capacity() const { return cur_.cap; }
     double loadFactor() const {
-        return buckets_.empty() ? 0.0 : static_cast<double>(size_) / static_cast<double>(buckets_.size());
+        return cur_.cap == 0 ? 0.0 : static_cast<double>(size_) / static_cast<double>(cur_.cap);
     }
 
     void clear() {
-        for (auto& head : buckets_) {
-            Node* cur = head;
-            while (cur) {
-                Node* nxt = cur->next;
-                delete cur;
-                cur = nxt;
-            }
-            head = nullptr;
-        }
+        old_.destroyAll();
+        old_.release();
+        cur_.destroyAll();
+        std::fill(cur_.ctrl.begin(), cur_.ctrl.end(), kEmpty);
+        cur_.growthLeft = cur_.cap * 7 / 8;
         size_ = 0;
     }
 
-    ~HashTable() { clear(); }
+    // clear() that also gives the memory back (keeps a minimal array).
+    void reset() {
+        old_.destroyAll();
+        old_.release();
+        cur_.destroyAll();
+        cur_.release();
+        cur_.allocate(kGroup);
+        size_ = 0;
+    }
+
+    ~HashTable() {
+        old_.destroyAll();
+        old_.release();
+        cur_.destroyAll();
+        cur_.release();
+    }
 
     HashTable(const HashTable&) = delete;
     HashTable& operator=(const HashTable&) = delete;
 
 private:
-    struct Node {
-        std::string key;
+    // ConcurrentHashTable hashes once to pick a shard and reuses the hash.
+    template <typename, typename, typename> friend class ConcurrentHashTable;
+
+    struct Slot {
+        std::uint64_t hash;
+        K key;
         V value;
-        Node* next;
     };
 
-    std::vector<Node*> buckets_;
-    std::size_t size_;
+    static constexpr std::size_t kGroup = 16;
+    static constexpr std::size_t kMigrateGroups = 4; // per put/erase while resizing
+    static constexpr std::int8_t kEmpty = -128;      // 0b10000000
+    static constexpr std::int8_t kDeleted = -2;      // 0b11111110; full slots are 0..127
+
+    static std::size_t slotsFor(std::size_t n) { return HashUtils::nextPow2(n < kGroup ? kGroup : n); }
+    // top 7 bits tag the slot, the low bits pick the first group
+    static std::int8_t fingerprint(std::uint64_t h) { return static_cast<std::int8_t>(h >> 57); }
+
+    // Bit i set <=> ctrl[i] matches, for the 16 control bytes at ctrl.
+#ifdef ALGOCITY_HASH_SSE2
+    static unsigned matchByte(const std::int8_t* ctrl, std::int8_t b) {
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(b))));
+    }
+    static unsigned matchEmptyOrDeleted(const std::int8_t* ctrl) {
+        __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), g)));
+    }
+#else
+    static unsigned matchByte(const std::int8_t* ctrl, std::int8_t b) {
+        unsigned m = 0;
+        for (unsigned i=0; i<kGroup; i++) m |= static_cast<unsigned>(ctrl[i] == b) << i;
+        return m;
+    }
+    static unsigned matchEmptyOrDeleted(const std::int8_t* ctrl) {
+        unsigned m = 0;
+        for (unsigned i=0; i<kGroup; i++) m |= static_cast<unsigned>(ctrl[i] < -1) << i;
+        return m;
+    }
+#endif
+    static unsigned matchEmpty(const std::int8_t* ctrl) { return matchByte(ctrl, kEmpty); }
 
-    std::size_t indexFor(const std::string& key) const {
-        std::uint64_t h = HashUtils::fnv1a64(key);
-        return static_cast<std::size_t>(h) & (buckets_.size() - 1); // power-of-two mask
+    static unsigned lowestBit(unsigned m) { // m != 0
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(m));
+#else
+        unsigned i = 0;
+        while (!(m & 1u)) { m >>= 1; ++i; }
+        return i;
+#endif
     }
 
-    Node* findNode(const std::string& key) const {
-        if (buckets_.empty()) return nullptr;
-        std::size_t idx = indexFor(key);
-        Node* cur = buckets_[idx];
-        while (cur) {
-            if (cur->key == key) return cur;
-            cur = cur->next;
+    // One slot array with its control bytes. Slots are raw storage,
+    // constructed only where ctrl is full.
+    struct Table {
+        std::vector<std::int8_t> ctrl;
+        Slot* slots{nullptr};
+        std::size_t cap{0};        // power of two, multiple of kGroup
+        std::size_t growthLeft{0}; // empty slots that may still be filled before resizing
+
+        void allocate(std::size_t n) {
+            cap = n;
+            ctrl.assign(n, kEmpty);
+            slots = std::allocator<Slot>().allocate(n);
+            growthLeft = n * 7 / 8;
+        }
+
+        void release() {
+            if (slots) std::allocator<Slot>().deallocate(slots, cap);
+            slots = nullptr;
+            ctrl.clear();
+            ctrl.shrink_to_fit();
+            cap = growthLeft = 0;
         }
-        return nullptr;
+
+        void destroyAll() {
+            for (std::size_t i=0; i<cap; i++) {
+                if (ctrl[i] >= 0) slots[i].~Slot();
+            }
+        }
+
+        // Groups are visited in triangular order (g, g+1, g+3, g+6, ...),
+        // which covers every group when their count is a power of two.
+        std::ptrdiff_t find(const K& key, std::uint64_t h) const {
+            const std::size_t groups = cap / kGroup;
+            std::size_t g = static_cast<std::size_t>(h) & (groups - 1);
+            const std::int8_t tag = fingerprint(h);
+            for (std::size_t step=1; step<=groups; step++) {
+                const std::int8_t* c = &ctrl[g * kGroup];
+                for (unsigned m = matchByte(c, tag); m; m &= m - 1) {
+                    std::size_t i = g * kGroup + lowestBit(m);
+                    if (slots[i].hash == h && slots[i].key == key) return static_cast<std::ptrdiff_t>(i);
+                }
+                if (matchEmpty(c)) return -1;
+                g = (g + step) & (groups - 1);
+            }
+            return -1;
+        }
+
+        // First empty or deleted slot on h's probe sequence (growthLeft
+        // keeps at least one empty slot around, so there always is one).
+        std::size_t freeSlot(std::uint64_t h) const {
+            const std::size_t groups = cap / kGroup;
+            std::size_t g = static_cast<std::size_t>(h) & (groups - 1);
+            for (std::size_t step=1; ; step++) {
+                unsigned m = matchEmptyOrDeleted(&ctrl[g * kGroup]);
+                if (m) return g * kGroup + lowestBit(m);
+                g = (g + step) & (groups - 1);
+            }
+        }
+
+        void mark(std::size_t i, std::uint64_t h) {
+            if (ctrl[i] == kEmpty) --growthLeft;
+            ctrl[i] = fingerprint(h);
+        }
+
+        // Probes only stop at a group with an empty slot. If this group
+        // already has one, nothing probes past it and the slot can be
+        // reused freely; otherwise leave a tombstone.
+        void unmark(std::size_t i) {
+            if (matchEmpty(&ctrl[i & ~(kGroup - 1)])) { ctrl[i] = kEmpty; ++growthLeft; }
+            else ctrl[i] = kDeleted;
+        }
+    };
+
+    Table cur_;               // new entries always go here
+    Table old_;               // previous array while a resize is in progress
+    std::size_t migrated_{0}; // old_ slots [0, migrated_) already moved
+    std::size_t size_{0};     // entries in both tables
+
+    void putHashed(const K& key, const V& value, std::uint64_t h) {
+        migrateSome();
+        if (Slot* s = find(key, h)) { s->value = value; return; }
+
+        std::size_t i = cur_.freeSlot(h);
+        if (cur_.growthLeft == 0 && cur_.ctrl[i] == kEmpty) {
+            // reclaim tombstones when they are what fills the table, else grow
+            startResize(size_ < cur_.cap * 7 / 16 ? cur_.cap : cur_.cap * 2);
+            i = cur_.freeSlot(h);
+        }
+        new (&cur_.slots[i]) Slot{h, key, value};
+        cur_.mark(i, h);
+        ++size_;
     }
 
-    void maybeResize() {
-        if (loadFactor() <= 0.7) return;
-        rehash(buckets_.size() * 2);
+    bool eraseHashed(const K& key, std::uint64_t h) {
+        migrateSome();
+        for (Table* t : {&cur_, &old_}) {
+            if (!t->slots) continue;
+            std::ptrdiff_t i = t->find(key, h);
+            if (i < 0) continue;
+            t->slots[i].~Slot();
+            t->unmark(static_cast<std::size_t>(i));
+            --size_;
+            return true;
+        }
+        return false;
     }
 
-    void rehash(std::size_t new_capacity) {
-        new_capacity = HashUtils::nextPow2(new_capacity);
-        std::vector<Node*> newBuckets(new_capacity, nullptr);
+    Slot* find(const K& key, std::uint64_t h) const {
+        std::ptrdiff_t i = cur_.find(key, h);
+        if (i >= 0) return &cur_.slots[i];
+        if (!old_.slots) return nullptr;
+        i = old_.find(key, h);
+        return i >= 0 ? &old_.slots[i] : nullptr;
+    }
 
-        for (Node* head : buckets_) {
-            Node* cur = head;
-            while (cur) {
-                Node* nxt = cur->next;
-                std::uint64_t h = HashUtils::fnv1a64(cur->key);
-                std::size_t idx = static_cast<std::size_t>(h) & (new_capacity - 1);
-                cur->next = newBuckets[idx];
-                newBuckets[idx] = cur;
-                cur = nxt;
-            }
+    void startResize(std::size_t new_capacity) {
+        finishMigration();
+        std::swap(old_, cur_);
+        cur_.allocate(slotsFor(new_capacity));
+        migrated_ = 0;
+        migrateSome();
+    }
+
+    // Moving never compares keys: a key lives in exactly one table.
+    void migrateSome(std::size_t groups = kMigrateGroups) {
+        if (!old_.slots) return;
+        std::size_t end = std::min(old_.cap, migrated_ + groups * kGroup);
+        for (; migrated_<end; migrated_++) {
+            if (old_.ctrl[migrated_] < 0) continue;
+            Slot& s = old_.slots[migrated_];
+            std::size_t j = cur_.freeSlot(s.hash);
+            new (&cur_.slots[j]) Slot{s.hash, std::move(s.key), std::move(s.value)};
+            cur_.mark(j, s.hash);
+            s.~Slot();
+            old_.ctrl[migrated_] = kDeleted; // keeps old_ probe chains intact
         }
-        buckets_.swap(newBuckets);
+        if (migrated_ == old_.cap) old_.release();
     }
-};
 
+    void finishMigration() { migrateSome(old_.cap); }
+};
@@ -1,7 +1,40 @@
 #include "structures/hash/HashUtils.hpp"
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// 64x64 -> 128 multiply: lo/hi halves of a*b
+static inline void mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& lo, std::uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    lo = static_cast<std::uint64_t>(r);
+    hi = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    lo = _umul128(a, b, &hi);
+#else
+    std::uint64_t ha = a >> 32, la = a & 0xffffffffULL, hb = b >> 32, lb = b & 0xffffffffULL;
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline std::uint64_t mulFold(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t lo, hi;
+    mul128(a, b, lo, hi);
+    return lo ^ hi;
+}
+
+static inline std::uint64_t read64(const unsigned char* p) { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+static inline std::uint64_t read32(const unsigned char* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
 
 namespace HashUtils {
-    std::uint64_t fnv1a64(const std::string& s) {
+    std::uint64_t fnv1a64(std::string_view s) {
         const std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
         const std::uint64_t FNV_PRIME  = 1099511628211ULL;
         std::uint64_t h = FNV_OFFSET;
@@ -12,6 +45,61 @@ namespace HashUtils {
         return h;
     }
 
+    std::uint64_t wordHash64(std::string_view s, std::uint64_t seed) {
+        const std::uint64_t k0 = 0xa0761d6478bd642fULL, k1 = 0xe7037ed1a0b428dbULL;
+        const std::uint64_t k2 = 0x8ebc6af09c88c6e3ULL, k3 = 0x589965cc75374cc3ULL;
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+        std::size_t n = s.size();
+        seed ^= mulFold(seed ^ k0, k1);
+
+        std::uint64_t a = 0, b = 0;
+        if (n <= 16) {
+            if (n >= 4) {
+                // two (possibly overlapping) 4-byte reads from each end
+                std::size_t mid = (n >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + mid);
+                b = (read32(p + n - 4) << 32) | read32(p + n - 4 - mid);
+            } else if (n > 0) {
+                a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+            }
+        } else {
+            std::size_t i = n;
+            if (i > 48) {
+                std::uint64_t lane1 = seed, lane2 = seed;
+                do {
+                    seed = mulFold(read64(p) ^ k1, read64(p + 8) ^ seed);
+                    lane1 = mulFold(read64(p + 16) ^ k2, read64(p + 24) ^ lane1);
+                    lane2 = mulFold(read64(p + 32) ^ k3, read64(p + 40) ^ lane2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= lane1 ^ lane2;
+            }
+            while (i > 16) {
+                seed = mulFold(read64(p) ^ k1, read64(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read64(p + i - 16); // last 16 bytes, overlapping what was mixed
+            b = read64(p + i - 8);
+        }
+        mul128(a ^ k1, b ^ seed, a, b);
+        return mulFold(a ^ k0 ^ n, b ^ k1);
+    }
+
+    std::uint64_t mulHi64(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t lo, hi;
+        mul128(a, b, lo, hi);
+        return hi;
+    }
+
+    std::uint64_t mix64(std::uint64_t x) {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
     std::size_t nextPow2(std::size_t n) {
         if (n < 2) return 2;
         std::size_t p = 1;
@@ -1,10 +1,34 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 namespace HashUtils {
     // FNV-1a 64-bit for strings (stable, simple, good distribution for learning)
-    std::uint64_t fnv1a64(const std::string& s);
+    std::uint64_t fnv1a64(std::string_view s);
+
+    // wyhash-style 64-bit string hash: reads 8 bytes at a time and mixes
+    // with 64x64->128 multiplies; keys over 48 bytes run three independent
+    // multiply lanes. Measured (hash function benchmark): about 2-4x the
+    // throughput of fnv1a64 on 25-50 byte keys, no faster on very short ones.
+    // Values depend on byte order. PerfectHash blobs (and so the graph
+    // snapshots) persist results of it: changing it needs a new hash id
+    // in PerfectHash.cpp, which makes old snapshots rebuild their index.
+    std::uint64_t wordHash64(std::string_view s, std::uint64_t seed = 0);
+
+    // High 64 bits of a*b: maps a uniform 64-bit hash onto [0, b).
+    std::uint64_t mulHi64(std::uint64_t a, std::uint64_t b);
+
+    // Hasher types for HashTable's Hash parameter.
+    struct Fnv1a {
+        std::uint64_t operator()(std::string_view s) const { return fnv1a64(s); }
+    };
+    struct WordHash {
+        std::uint64_t operator()(std::string_view s) const { return wordHash64(s); }
+    };
+
+    // 64-bit integer mixer (splitmix64 finalizer) for integer keys
+    std::uint64_t mix64(std::uint64_t x);
 
     // Next power of two >= n (used for table sizing)
     std::size_t nextPow2(std::size_t n);
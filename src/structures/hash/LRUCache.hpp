@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include "structures/hash/HashUtils.hpp"
+
+// Bounded LRU cache for 64-bit integer keys.
+// - entries live in a fixed vector, linked into a recency list by index
+// - key -> entry index via linear probing (backward-shift delete, no tombstones)
+// - get() refreshes recency, put() evicts the least recently used entry
+
+template <typename V>
+class LRUCache {
+public:
+    explicit LRUCache(std::size_t capacity)
+        : capacity_(capacity), index_(HashUtils::nextPow2(capacity * 2), -1) {
+        entries_.reserve(capacity);
+    }
+
+    std::optional<V> get(std::uint64_t key) {
+        int e = find(key);
+        if (e < 0) { ++misses_; return std::nullopt; }
+        ++hits_;
+        touch(e);
+        return entries_[e].value;
+    }
+
+    // Insert or overwrite
+    void put(std::uint64_t key, const V& value) {
+        if (capacity_ == 0) return;
+        int e = find(key);
+        if (e >= 0) {
+            entries_[e].value = value;
+            touch(e);
+            return;
+        }
+        if (entries_.size() < capacity_) {
+            e = static_cast<int>(entries_.size());
+            entries_.push_back({key, value, -1, -1});
+        } else {
+            e = tail_; // reuse the LRU slot
+            unlink(e);
+            eraseIndex(entries_[e].key);
+            entries_[e].key = key;
+            entries_[e].value = value;
+            ++evictions_;
+        }
+        pushFront(e);
+        insertIndex(key, e);
+    }
+
+    void clear() {
+        if (entries_.empty()) return; // cheap when called on every graph edit
+        entries_.clear();
+        std::fill(index_.begin(), index_.end(), -1);
+        head_ = tail_ = -1;
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    std::size_t capacity() const { return capacity_; }
+    std::uint64_t hits() const { return hits_; }
+    std::uint64_t misses() const { return misses_; }
+    std::uint64_t evictions() const { return evictions_; }
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        V value;
+        int prev;
+        int next;
+    };
+
+    std::size_t capacity_;
+    std::vector<Entry> entries_;
+    std::vector<int> index_; // slot -> entry index, -1 = empty
+    int head_{-1};           // most recently used
+    int tail_{-1};           // least recently used
+    std::uint64_t hits_{0}, misses_{0}, evictions_{0};
+
+    std::size_t slotFor(std::uint64_t key) const {
+        return static_cast<std::size_t>(HashUtils::mix64(key)) & (index_.size() - 1);
+    }
+
+    int find(std::uint64_t key) const {
+        for (std::size_t i = slotFor(key);; i = (i + 1) & (index_.size() - 1)) {
+            int e = index_[i];
+            if (e < 0) return -1;
+            if (entries_[e].key == key) return e;
+        }
+    }
+
+    void insertIndex(std::uint64_t key, int e) {
+        std::size_t i = slotFor(key);
+        while (index_[i] >= 0) i = (i + 1) & (index_.size() - 1);
+        index_[i] = e;
+    }
+
+    void eraseIndex(std::uint64_t key) {
+        const std::size_t mask = index_.size() - 1;
+        std::size_t i = slotFor(key);
+        while (entries_[index_[i]].key != key) i = (i + 1) & mask;
+        // shift later members of the probe run back into the hole
+        for (std::size_t j = (i + 1) & mask; index_[j] >= 0; j = (j + 1) & mask) {
+            std::size_t home = slotFor(entries_[index_[j]].key);
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                index_[i] = index_[j];
+                i = j;
+            }
+        }
+        index_[i] = -1;
+    }
+
+    void unlink(int e) {
+        Entry& x = entries_[e];
+        if (x.prev >= 0) entries_[x.prev].next = x.next; else head_ = x.next;
+        if (x.next >= 0) entries_[x.next].prev = x.prev; else tail_ = x.prev;
+        x.prev = x.next = -1;
+    }
+
+    void pushFront(int e) {
+        entries_[e].prev = -1;
+        entries_[e].next = head_;
+        if (head_ >= 0) entries_[head_].prev = e;
+        head_ = e;
+        if (tail_ < 0) tail_ = e;
+    }
+
+    void touch(int e) {
+        if (e == head_) return;
+        unlink(e);
+        pushFront(e);
+    }
+};
@@ -0,0 +1,209 @@
+#include "structures/hash/PerfectHash.hpp"
+#include "structures/hash/HashUtils.hpp"
+#include <algorithm>
+#include <cstring>
+
+static const char kMphMagic[8] = {'A','C','M','P','H','\0','\0','\0'};
+static const std::uint32_t kMphVersion = 3; // 3: fingerprint and value share one 8-byte slot
+// The blob stores pilots chosen for one particular key hash, so it names
+// it: bump this whenever wordHash64 changes its values.
+static const std::uint32_t kMphHash = 1;
+static const int kSeedAttempts = 16;
+
+static std::size_t align8(std::size_t n) { return (n + 7) / 8 * 8; }
+
+static std::uint64_t fingerprintOf(std::uint64_t h) { return h & 0xffff; }
+
+std::size_t PerfectHash::blobSize(std::uint64_t keys, std::uint64_t slots, std::uint64_t buckets) {
+    return sizeof(Header) + align8(buckets * 2) + align8((slots - keys) * 4) + keys * sizeof(Slot);
+}
+
+// The pilot perturbs the key's hash before it is mapped onto the slots.
+std::uint64_t PerfectHash::slotOf(std::uint64_t h) const {
+    std::uint64_t b = HashUtils::mulHi64(h, buckets_);
+    return HashUtils::mulHi64(HashUtils::mix64(h ^ (pilots_[b] * 0x9e3779b97f4a7c15ULL)), slots_);
+}
+
+void PerfectHash::swap(PerfectHash& other) {
+    own_.swap(other.own_); // the views below move along with the buffers
+    std::swap(base_, other.base_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(keys_, other.keys_);
+    std::swap(slots_, other.slots_);
+    std::swap(buckets_, other.buckets_);
+    std::swap(seed_, other.seed_);
+    std::swap(pilots_, other.pilots_);
+    std::swap(remap_, other.remap_);
+    std::swap(table_, other.table_);
+}
+
+void PerfectHash::clear() {
+    own_.clear();
+    own_.shrink_to_fit();
+    base_ = nullptr;
+    bytes_ = 0;
+    keys_ = slots_ = buckets_ = seed_ = 0;
+    pilots_ = nullptr;
+    remap_ = nullptr;
+    table_ = nullptr;
+}
+
+bool PerfectHash::attach(const void* blob, std::size_t bytes) {
+    clear();
+    if (!blob || bytes < sizeof(Header) || reinterpret_cast<std::uintptr_t>(blob) % 8 != 0) return false;
+    Header h;
+    std::memcpy(&h, blob, sizeof(Header));
+    if (std::memcmp(h.magic, kMphMagic, sizeof(kMphMagic)) != 0 || h.version != kMphVersion
+        || h.hash != kMphHash) return false;
+    if (h.keys >= (1ULL << 31) || h.slots < h.keys || h.slots - h.keys > h.keys / 8 + 64
+        || (h.keys > 0 && (h.buckets == 0 || h.buckets > h.keys))) return false;
+    if (blobSize(h.keys, h.slots, h.buckets) > bytes) return false;
+
+    base_ = static_cast<const unsigned char*>(blob);
+    bytes_ = blobSize(h.keys, h.slots, h.buckets);
+    keys_ = h.keys;
+    slots_ = h.slots;
+    buckets_ = h.buckets;
+    seed_ = h.seed;
+    std::size_t at = sizeof(Header);
+    pilots_ = reinterpret_cast<const std::uint16_t*>(base_ + at);
+    at += align8(buckets_ * 2);
+    remap_ = reinterpret_cast<const std::uint32_t*>(base_ + at);
+    at += align8((slots_ - keys_) * 4);
+    table_ = reinterpret_cast<const Slot*>(base_ + at);
+    for (std::uint64_t i=0; i<slots_-keys_; i++) {
+        if (remap_[i] >= keys_) { clear(); return false; }
+    }
+    return true;
+}
+
+bool PerfectHash::load(const void* blob, std::size_t bytes) {
+    std::vector<std::uint64_t> copy((bytes + 7) / 8);
+    if (bytes) std::memcpy(copy.data(), blob, bytes);
+    if (!attach(copy.data(), bytes)) return false;
+    own_.swap(copy); // same buffer, pointers stay valid
+    return true;
+}
+
+bool PerfectHash::build(const std::vector<std::string_view>& keys, const std::vector<int>& values) {
+    clear();
+    const std::uint64_t n = keys.size();
+    if (values.size() != n || n >= (1ULL << 31)) return false;
+    const std::uint64_t buckets = n ? (n + 3) / 4 : 0;           // ~4 keys per bucket
+    const std::uint64_t slots = n + (n ? n / 32 + 1 : 0);        // ~3% spare slots
+
+    std::vector<std::uint64_t> hash(n);
+    std::vector<std::uint32_t> start(buckets + 1), order(n), byBucket;
+    std::vector<std::uint16_t> pilots(buckets);
+    std::vector<char> taken(slots);
+    std::vector<std::uint32_t> slotOfKey(n);
+    std::vector<std::uint64_t> tried;
+
+    for (int attempt=0; attempt<kSeedAttempts; attempt++) {
+        const std::uint64_t seed = HashUtils::mix64(static_cast<std::uint64_t>(attempt) + 1);
+        for (std::uint64_t i=0; i<n; i++) hash[i] = HashUtils::wordHash64(keys[i], seed);
+
+        // counting sort of keys by bucket, then buckets by size (largest first)
+        std::fill(start.begin(), start.end(), 0);
+        for (std::uint64_t i=0; i<n; i++) start[HashUtils::mulHi64(hash[i], buckets) + 1]++;
+        for (std::uint64_t b=0; b<buckets; b++) start[b + 1] += start[b];
+        {
+            std::vector<std::uint32_t> fill(start.begin(), start.end() - 1);
+            for (std::uint64_t i=0; i<n; i++) order[fill[HashUtils::mulHi64(hash[i], buckets)]++] = static_cast<std::uint32_t>(i);
+        }
+        byBucket.resize(buckets);
+        for (std::uint64_t b=0; b<buckets; b++) byBucket[b] = static_cast<std::uint32_t>(b);
+        std::stable_sort(byBucket.begin(), byBucket.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return start[a + 1] - start[a] > start[b + 1] - start[b];
+        });
+
+        std::fill(taken.begin(), taken.end(), 0);
+        bool ok = true;
+        for (std::uint32_t b : byBucket) {
+            std::uint32_t lo = start[b], hi = start[b + 1];
+            if (lo == hi) { pilots[b] = 0; continue; }
+            // equal 64-bit hashes can never be separated: try another seed
+            for (std::uint32_t x=lo; x<hi && ok; x++) {
+                for (std::uint32_t y=x+1; y<hi; y++) if (hash[order[x]] == hash[order[y]]) { ok = false; break; }
+            }
+            if (!ok) break;
+
+            bool placed = false;
+            for (std::uint32_t p=0; p<=0xffff && !placed; p++) {
+                tried.clear();
+                bool fits = true;
+                for (std::uint32_t x=lo; x<hi && fits; x++) {
+                    std::uint64_t s = HashUtils::mulHi64(HashUtils::mix64(hash[order[x]] ^ (p * 0x9e3779b97f4a7c15ULL)), slots);
+                    if (taken[s] || std::find(tried.begin(), tried.end(), s) != tried.end()) fits = false;
+                    else tried.push_back(s);
+                }
+                if (!fits) continue;
+                for (std::uint32_t x=lo; x<hi; x++) {
+                    taken[tried[x - lo]] = 1;
+                    slotOfKey[order[x]] = static_cast<std::uint32_t>(tried[x - lo]);
+                }
+                pilots[b] = static_cast<std::uint16_t>(p);
+                placed = true;
+            }
+            if (!placed) { ok = false; break; }
+        }
+        if (!ok) continue;
+
+        // lay out the blob
+        own_.assign(blobSize(n, slots, buckets) / 8, 0);
+        unsigned char* base = reinterpret_cast<unsigned char*>(own_.data());
+        Header h{};
+        std::memcpy(h.magic, kMphMagic, sizeof(kMphMagic));
+        h.version = kMphVersion;
+        h.hash = kMphHash;
+        h.keys = n;
+        h.slots = slots;
+        h.buckets = buckets;
+        h.seed = seed;
+        std::memcpy(base, &h, sizeof(Header));
+        std::size_t at = sizeof(Header);
+        if (buckets) std::memcpy(base + at, pilots.data(), buckets * 2);
+        at += align8(buckets * 2);
+        std::uint32_t* remap = reinterpret_cast<std::uint32_t*>(base + at);
+        at += align8((slots - n) * 4);
+        Slot* table = reinterpret_cast<Slot*>(base + at);
+
+        // slots past the end fill the holes below n, in order
+        std::uint64_t hole = 0;
+        for (std::uint64_t s=n; s<slots; s++) {
+            while (hole < n && taken[hole]) hole++;
+            remap[s - n] = static_cast<std::uint32_t>(taken[s] ? hole++ : 0);
+        }
+        for (std::uint64_t i=0; i<n; i++) {
+            std::uint64_t s = slotOfKey[i];
+            if (s >= n) s = remap[s - n];
+            table[s].fingerprint = static_cast<std::uint16_t>(fingerprintOf(hash[i]));
+            table[s].value = values[i];
+        }
+        std::vector<std::uint64_t> blob;
+        blob.swap(own_);
+        if (!attach(blob.data(), blob.size() * 8)) return false;
+        own_.swap(blob);
+        return true;
+    }
+    return false;
+}
+
+int PerfectHash::find(std::string_view key) const {
+    if (keys_ == 0) return -1;
+    std::uint64_t h = HashUtils::wordHash64(key, seed_);
+    std::uint64_t s = slotOf(h);
+    if (s >= keys_) s = remap_[s - keys_];
+    const Slot& slot = table_[s];
+    if (slot.fingerprint != fingerprintOf(h)) return -1;
+    return slot.value;
+}
+
+void PerfectHash::write(std::ostream& out) const {
+    if (base_) out.write(reinterpret_cast<const char*>(base_), static_cast<std::streamsize>(bytes_));
+}
+
+double PerfectHash::hashBitsPerKey() const {
+    if (keys_ == 0) return 0.0;
+    return static_cast<double>(buckets_ * 16 + (slots_ - keys_) * 32) / static_cast<double>(keys_);
+}
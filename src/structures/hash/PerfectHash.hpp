@@ -0,0 +1,87 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+// Minimal perfect hash for a frozen set of string keys (PTHash-style).
+// - keys go to buckets of ~4; each bucket stores a 16-bit pilot chosen at
+//   build time so that its keys land on distinct free slots of a table
+//   ~3% larger than the key count; the few slots past the end are
+//   remapped into the holes. ~5 bits per key for the hash itself.
+// - each 8-byte slot holds a 16-bit fingerprint (compact key check: an
+//   absent key is reported as present with odds ~1/65536; callers that
+//   keep the keys confirm the hit) next to the key's int value
+// - lookup: pilot, then slot, i.e. two memory accesses (three for the
+//   ~3% of keys whose slot is remapped)
+// - the whole structure is one flat, 8-byte aligned blob: write() saves
+//   it, attach() uses it in place (e.g. straight from an mmap'ed file).
+//   Like the graph snapshots that embed it, it is native-endian and only
+//   valid for the wordHash64 it was built with (the header records both
+//   the format version and a hash id; a mismatch fails attach())
+class PerfectHash {
+public:
+    PerfectHash() = default;
+    PerfectHash(const PerfectHash&) = delete;
+    PerfectHash& operator=(const PerfectHash&) = delete;
+
+    // keys[i] -> values[i]. Keys must be distinct; false if they are not.
+    bool build(const std::vector<std::string_view>& keys, const std::vector<int>& values);
+    // From any table with forEach(key, value), e.g. a frozen HashTable<int>.
+    template <typename Table>
+    bool buildFrom(const Table& table) {
+        std::vector<std::string_view> keys;
+        std::vector<int> values;
+        table.forEach([&](std::string_view k, int v) { keys.push_back(k); values.push_back(v); });
+        return build(keys, values);
+    }
+
+    // Use a blob produced by write()/data() without copying; it must stay
+    // alive and 8-byte aligned. false (and empty) if it is malformed.
+    bool attach(const void* blob, std::size_t bytes);
+    // Same, but keeps its own copy.
+    bool load(const void* blob, std::size_t bytes);
+
+    int find(std::string_view key) const; // value, or -1 if absent
+    bool empty() const { return keys_ == 0; }
+    std::size_t size() const { return keys_; }
+
+    const void* data() const { return base_; }
+    std::size_t bytes() const { return bytes_; }
+    void write(std::ostream& out) const;
+    double hashBitsPerKey() const; // pilots + remap, excluding fingerprints and values
+
+    void clear();
+    void swap(PerfectHash& other);
+
+private:
+    // Fingerprint and value side by side: a hit reads one 8-byte slot.
+    struct Slot {
+        std::uint16_t fingerprint;
+        std::uint16_t reserved;
+        std::int32_t value;
+    };
+    static_assert(sizeof(Slot) == 8, "PerfectHash::Slot is part of the blob format");
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t hash;     // key hash the pilots were chosen for
+        std::uint64_t keys;
+        std::uint64_t slots;
+        std::uint64_t buckets;
+        std::uint64_t seed;
+    };
+
+    std::vector<std::uint64_t> own_; // blob storage when built / loaded here
+    const unsigned char* base_{nullptr};
+    std::size_t bytes_{0};
+    std::uint64_t keys_{0}, slots_{0}, buckets_{0}, seed_{0};
+    const std::uint16_t* pilots_{nullptr};       // [buckets]
+    const std::uint32_t* remap_{nullptr};        // [slots - keys]: slot >= keys -> hole
+    const Slot* table_{nullptr};                 // [keys]
+
+    static std::size_t blobSize(std::uint64_t keys, std::uint64_t slots, std::uint64_t buckets);
+    std::uint64_t slotOf(std::uint64_t h) const;
+};
@@ -0,0 +1,46 @@
+#include "structures/hash/StringArena.hpp"
+#include <cstring>
+#include <utility>
+
+char* StringArena::newChunk(std::size_t bytes) {
+    chunks_.emplace_back(new char[bytes]);
+    reserved_ += bytes;
+    return chunks_.back().get();
+}
+
+void StringArena::reserve(std::size_t bytes) {
+    if (bytes <= left_) return;
+    cur_ = newChunk(bytes > chunkBytes_ ? bytes : chunkBytes_);
+    left_ = bytes > chunkBytes_ ? bytes : chunkBytes_;
+}
+
+std::string_view StringArena::add(std::string_view s) {
+    if (s.empty()) return {};
+    char* p;
+    if (s.size() > chunkBytes_ / 4 && s.size() > left_) {
+        p = newChunk(s.size()); // oversized string: own chunk, keep the current one
+    } else {
+        reserve(s.size());
+        p = cur_;
+        cur_ += s.size();
+        left_ -= s.size();
+    }
+    std::memcpy(p, s.data(), s.size());
+    used_ += s.size();
+    return std::string_view(p, s.size());
+}
+
+void StringArena::swap(StringArena& other) {
+    chunks_.swap(other.chunks_);
+    std::swap(chunkBytes_, other.chunkBytes_);
+    std::swap(cur_, other.cur_);
+    std::swap(left_, other.left_);
+    std::swap(used_, other.used_);
+    std::swap(reserved_, other.reserved_);
+}
+
+void StringArena::clear() {
+    chunks_.clear();
+    cur_ = nullptr;
+    left_ = used_ = reserved_ = 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Append-only storage for many small strings (e.g. node names).
+// - bytes live in large chunks that never move, so returned views stay
+//   valid until clear()
+// - one allocation per chunk instead of one per string
+class StringArena {
+public:
+    explicit StringArena(std::size_t chunkBytes = 64 * 1024) : chunkBytes_(chunkBytes) {}
+
+    // Copies s into the arena.
+    std::string_view add(std::string_view s);
+    // Make room for `bytes` more without further allocations.
+    void reserve(std::size_t bytes);
+    void clear();
+    void swap(StringArena& other); // views into either arena stay valid
+
+    std::size_t bytes() const { return used_; }        // stored string bytes
+    std::size_t capacity() const { return reserved_; } // allocated chunk bytes
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t chunkBytes_;
+    char* cur_{nullptr};
+    std::size_t left_{0};
+    std::size_t used_{0};
+    std::size_t reserved_{0};
+
+    char* newChunk(std::size_t bytes);
+};
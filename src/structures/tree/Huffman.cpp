@@ -1,157 +1,394 @@
 #include "structures/tree/Huffman.hpp"
-#include <queue>
+#include <algorithm>
 #include <fstream>
+#include <cstring>
 
-static Huffman::Node* makeNode(int ch, std::uint64_t f, Huffman::Node* l=nullptr, Huffman::Node* r=nullptr){
-    auto* n = new Huffman::Node();
-    n->ch = ch; n->f = f; n->left = l; n->right = r;
-    return n;
-}
+// Code lengths of an optimal prefix code, computed in place (Moffat &
+// Katajainen): a holds the counts sorted ascending and ends up holding the
+// matching code lengths, longest first. No tree, no allocation.
+static void minimumRedundancy(std::vector<std::uint64_t>& a) {
+    const long n = static_cast<long>(a.size());
+    if (n == 0) return;
+    if (n == 1) { a[0] = 0; return; }
 
-struct CmpNode {
-    bool operator()(const Huffman::Node* a, const Huffman::Node* b) const {
-        return a->f > b->f;
+    // pass 1: left to right, combine and record parent pointers
+    a[0] += a[1];
+    long root = 0, leaf = 2;
+    for (long next=1; next<n-1; next++) {
+        if (leaf >= n || a[root] < a[leaf]) { a[next] = a[root]; a[root++] = static_cast<std::uint64_t>(next); }
+        else a[next] = a[leaf++];
+        if (leaf >= n || (root < next && a[root] < a[leaf])) { a[next] += a[root]; a[root++] = static_cast<std::uint64_t>(next); }
+        else a[next] += a[leaf++];
     }
-};
-
-Huffman::Node* Huffman::buildTree(const std::vector<std::uint32_t>& freq) {
-    std::priority_queue<Node*, std::vector<Node*>, CmpNode> pq;
-    for (int i=0;i<256;i++) {
-        if (freq[i] > 0) pq.push(makeNode(i, freq[i]));
+    // pass 2: right to left, internal node depths
+    a[n - 2] = 0;
+    for (long next=n-3; next>=0; next--) a[next] = a[a[next]] + 1;
+    // pass 3: right to left, leaf depths
+    long avail = 1, used = 0, next = n - 1;
+    std::uint64_t depth = 0;
+    root = n - 2;
+    while (avail > 0) {
+        while (root >= 0 && a[root] == depth) { used++; root--; }
+        while (avail > used) { a[next--] = depth; avail--; }
+        avail = 2 * used;
+        depth++;
+        used = 0;
     }
-    if (pq.empty()) return makeNode(-1, 0);
-    if (pq.size()==1) {
-        // single symbol: add dummy
-        Node* only = pq.top(); pq.pop();
-        pq.push(makeNode(-1, only->f, only, makeNode(0,0)));
+}
+
+std::vector<std::uint8_t> Huffman::codeLengths(const std::vector<std::uint64_t>& freq) {
+    std::vector<std::uint8_t> lengths(256, 0);
+    std::vector<int> syms;
+    for (int s=0; s<256; s++) if (freq[s] > 0) syms.push_back(s);
+    if (syms.empty()) return lengths;
+    if (syms.size() == 1) { lengths[syms[0]] = 1; return lengths; }
+
+    std::sort(syms.begin(), syms.end(), [&](int a, int b) {
+        return freq[a] != freq[b] ? freq[a] < freq[b] : a < b;
+    });
+    std::vector<std::uint64_t> a(syms.size());
+    for (std::size_t i=0; i<syms.size(); i++) a[i] = freq[syms[i]];
+    minimumRedundancy(a);
+
+    // Cap at kMaxCodeLen: clamp, then restore the Kraft sum by moving one
+    // leaf at a time one level down (deflate encoders do the same).
+    std::vector<std::uint32_t> count(kMaxCodeLen + 1, 0);
+    for (auto len : a) count[std::min<std::uint64_t>(len, kMaxCodeLen)]++;
+    std::uint32_t kraft = 0;
+    for (int len=1; len<=kMaxCodeLen; len++) kraft += count[len] << (kMaxCodeLen - len);
+    while (kraft > (1u << kMaxCodeLen)) {
+        count[kMaxCodeLen]--;
+        for (int len=kMaxCodeLen-1; len>0; len--) {
+            if (count[len]) { count[len]--; count[len + 1] += 2; break; }
+        }
+        kraft--;
     }
-    while (pq.size() > 1) {
-        Node* a = pq.top(); pq.pop();
-        Node* b = pq.top(); pq.pop();
-        pq.push(makeNode(-1, a->f + b->f, a, b));
+    // rarest symbols (front of syms) take the longest codes
+    std::size_t i = 0;
+    for (int len=kMaxCodeLen; len>0; len--) {
+        for (std::uint32_t k=0; k<count[len]; k++) lengths[syms[i++]] = static_cast<std::uint8_t>(len);
     }
-    return pq.top();
+    return lengths;
 }
 
-void Huffman::buildCodes(Node* n, std::vector<std::vector<bool>>& codes, std::vector<bool>& cur) {
-    if (!n) return;
-    if (n->ch >= 0) {
-        codes[n->ch] = cur;
-        return;
+bool Huffman::canonicalCodes(const std::vector<std::uint8_t>& lengths, std::vector<std::uint32_t>& codes) {
+    if (lengths.size() != 256) return false;
+    std::vector<std::uint32_t> count(kMaxCodeLen + 1, 0);
+    for (auto len : lengths) {
+        if (len > kMaxCodeLen) return false;
+        count[len]++;
     }
-    cur.push_back(false);
-    buildCodes(n->left, codes, cur);
-    cur.pop_back();
+    count[0] = 0;
+    std::uint32_t kraft = 0;
+    for (int len=1; len<=kMaxCodeLen; len++) kraft += count[len] << (kMaxCodeLen - len);
+    if (kraft > (1u << kMaxCodeLen)) return false;
+
+    // shorter codes first, then by symbol
+    std::vector<std::uint32_t> next(kMaxCodeLen + 2, 0);
+    for (int len=1; len<=kMaxCodeLen; len++) next[len + 1] = (next[len] + count[len]) << 1;
+    codes.assign(256, 0);
+    for (int s=0; s<256; s++) {
+        int len = lengths[s];
+        if (!len) continue;
+        std::uint32_t c = next[len]++, rev = 0;
+        for (int b=0; b<len; b++) rev |= ((c >> b) & 1u) << (len - 1 - b);
+        codes[s] = rev;
+    }
+    return true;
+}
+
+// Table-driven decoding. The stream is LSB-first, so the next k bits of
+// the stream are the low k bits of peekBits(); a code's first bit is bit 0
+// of its integer form.
+namespace {
+
+const int kPrimaryBits = 11; // first-level index width; longer codes add <= 4 bits
+const std::uint32_t kNoLink = 0xffffffffu;
+
+struct DecodeEntry {
+    std::uint8_t sym[2];
+    std::uint8_t count;  // symbols decoded by this entry; 0 = second level (or not a code)
+    std::uint8_t bits;   // bits consumed for all of them (second-level index width if count == 0)
+    std::uint8_t first;  // bits consumed by sym[0] alone
+    std::uint32_t link{kNoLink}; // second-level table offset (count == 0)
+};
+
+struct DecodeTable {
+    std::vector<DecodeEntry> primary;
+    std::vector<DecodeEntry> sub;
+};
+
+std::uint64_t lowMask(int n) { return (1ULL << n) - 1; }
 
-    cur.push_back(true);
-    buildCodes(n->right, codes, cur);
-    cur.pop_back();
+// At least 57 valid bits from bit pos on (zeros past the end).
+std::uint64_t peekBits(const std::uint8_t* data, std::size_t size, std::uint64_t pos) {
+    std::size_t byte = static_cast<std::size_t>(pos >> 3);
+    std::uint64_t w = 0;
+    if (byte + 8 <= size) {
+        std::memcpy(&w, data + byte, 8); // little-endian hosts
+    } else {
+        for (std::size_t i=0; byte + i < size; i++) w |= static_cast<std::uint64_t>(data[byte + i]) << (8 * i);
+    }
+    return w >> (pos & 7);
 }
 
-void Huffman::destroy(Node* n) {
-    if (!n) return;
-    destroy(n->left);
-    destroy(n->right);
-    delete n;
+void fill(DecodeEntry* table, int width, std::uint32_t code, int len, int sym) {
+    for (std::uint32_t k=0; k < (1u << (width - len)); k++) {
+        DecodeEntry& e = table[code | (k << len)];
+        e.sym[0] = static_cast<std::uint8_t>(sym);
+        e.count = 1;
+        e.bits = e.first = static_cast<std::uint8_t>(len);
+    }
 }
 
-void Huffman::writeBits(const std::vector<bool>& bits, std::vector<std::uint8_t>& out, std::uint32_t& bitLen) {
-    for (bool b : bits) {
-        std::uint32_t i = bitLen++;
-        std::size_t byte = i / 8;
-        std::size_t off  = i % 8;
-        if (byte >= out.size()) out.push_back(0);
-        if (b) out[byte] |= static_cast<std::uint8_t>(1u << off);
+DecodeTable buildDecodeTable(const std::vector<std::uint8_t>& lengths, const std::vector<std::uint32_t>& codes) {
+    DecodeTable t;
+    t.primary.assign(std::size_t(1) << kPrimaryBits, DecodeEntry{{0, 0}, 0, 0, 0, kNoLink});
+
+    // longest code under each primary prefix sizes its second-level table
+    std::vector<int> longest(t.primary.size(), 0);
+    for (int s=0; s<256; s++) {
+        if (!lengths[s]) continue;
+        if (lengths[s] <= kPrimaryBits) fill(t.primary.data(), kPrimaryBits, codes[s], lengths[s], s);
+        else {
+            int& l = longest[codes[s] & lowMask(kPrimaryBits)];
+            l = std::max<int>(l, lengths[s]);
+        }
+    }
+    for (std::size_t p=0; p<t.primary.size(); p++) {
+        if (!longest[p]) continue;
+        int width = longest[p] - kPrimaryBits;
+        t.primary[p].bits = static_cast<std::uint8_t>(width);
+        t.primary[p].link = static_cast<std::uint32_t>(t.sub.size());
+        t.sub.resize(t.sub.size() + (std::size_t(1) << width), DecodeEntry{{0, 0}, 0, 0, 0, kNoLink});
     }
+    for (int s=0; s<256; s++) {
+        if (lengths[s] <= kPrimaryBits) continue;
+        const DecodeEntry& p = t.primary[codes[s] & lowMask(kPrimaryBits)];
+        fill(&t.sub[p.link], p.bits, codes[s] >> kPrimaryBits, lengths[s] - kPrimaryBits, s);
+    }
+
+    // pair up: if a second whole code fits in the bits left over, take it too
+    std::vector<DecodeEntry> single = t.primary;
+    for (std::size_t i=0; i<t.primary.size(); i++) {
+        DecodeEntry& e = t.primary[i];
+        if (e.count != 1) continue;
+        const DecodeEntry& next = single[i >> e.first];
+        if (next.count == 1 && next.first <= kPrimaryBits - e.first) {
+            e.sym[1] = next.sym[0];
+            e.count = 2;
+            e.bits = static_cast<std::uint8_t>(e.first + next.first);
+        }
+    }
+    return t;
 }
 
-bool Huffman::readBit(const std::vector<std::uint8_t>& in, std::uint32_t i) {
-    std::size_t byte = i / 8;
-    std::size_t off  = i % 8;
-    return (in[byte] >> off) & 1u;
 }
 
-HuffmanBlob Huffman::compress(const std::string& input) {
+HuffmanBlob Huffman::compress(std::string_view input) {
     HuffmanBlob blob;
-    blob.freq.assign(256, 0);
+    std::vector<std::uint64_t> freq(256, 0);
+    for (unsigned char c : input) freq[c]++;
 
-    for (unsigned char c : input) blob.freq[c]++;
+    blob.lengths = codeLengths(freq);
+    blob.symbols = input.size();
+    std::vector<std::uint32_t> codes;
+    canonicalCodes(blob.lengths, codes);
+    // (code, length) side by side: one load per symbol
+    std::uint32_t packed[256];
+    for (int s=0; s<256; s++) packed[s] = codes[s] | (static_cast<std::uint32_t>(blob.lengths[s]) << 16);
 
-    Node* root = buildTree(blob.freq);
-    std::vector<std::vector<bool>> codes(256);
-    std::vector<bool> cur;
-    buildCodes(root, codes, cur);
-
-    blob.data.clear();
+    // the counts give the exact output size up front
     blob.bitLen = 0;
+    for (int s=0; s<256; s++) blob.bitLen += freq[s] * blob.lengths[s];
+    blob.data.assign(static_cast<std::size_t>((blob.bitLen + 63) / 64 * 8), 0);
+
+    std::uint8_t* out = blob.data.data();
+    std::uint64_t acc = 0; // pending bits, LSB-first
+    unsigned fill = 0;     // valid bits in acc, < 64
     for (unsigned char c : input) {
-        writeBits(codes[c], blob.data, blob.bitLen);
+        std::uint64_t code = packed[c] & 0xffff;
+        unsigned len = packed[c] >> 16;
+        acc |= code << fill;
+        fill += len;
+        if (fill >= 64) {
+            std::memcpy(out, &acc, 8); // little-endian hosts
+            out += 8;
+            fill -= 64;
+            acc = fill ? code >> (len - fill) : 0; // bits that did not fit
+        }
     }
-
-    destroy(root);
+    if (fill) std::memcpy(out, &acc, 8);
+    blob.data.resize(static_cast<std::size_t>((blob.bitLen + 7) / 8));
     return blob;
 }
 
 std::string Huffman::decompress(const HuffmanBlob& blob) {
-    Node* root = buildTree(blob.freq);
-    std::string out;
-    out.reserve(1024);
-
-    Node* cur = root;
-    for (std::uint32_t i=0; i<blob.bitLen; i++) {
-        bool b = readBit(blob.data, i);
-        cur = b ? cur->right : cur->left;
-        if (!cur) break;
-        if (cur->ch >= 0) {
-            out.push_back(static_cast<char>(cur->ch));
-            cur = root;
+    std::vector<std::uint32_t> codes;
+    if (!canonicalCodes(blob.lengths, codes)) return "";
+    const DecodeTable t = buildDecodeTable(blob.lengths, codes);
+
+    // every code is at least one bit, which bounds a corrupt symbol count
+    const std::uint64_t bitLen = std::min<std::uint64_t>(blob.bitLen, blob.data.size() * 8ULL);
+    const std::uint64_t total = std::min(blob.symbols, bitLen);
+    std::string out(static_cast<std::size_t>(total), '\0');
+    char* o = &out[0];
+    const std::uint8_t* data = blob.data.data();
+    const std::size_t size = blob.data.size();
+
+    std::uint64_t n = 0, pos = 0;
+    while (n < total && pos < bitLen) {
+        // hot loop: two primary lookups per 8-byte load, up to 4 symbols
+        while (n + 4 <= total && (pos >> 3) + 8 <= size) {
+            std::uint64_t w;
+            std::memcpy(&w, data + (pos >> 3), 8);
+            w >>= pos & 7;
+            const DecodeEntry& a = t.primary[w & lowMask(kPrimaryBits)];
+            if (!a.count) break;
+            o[n] = static_cast<char>(a.sym[0]);
+            o[n + 1] = static_cast<char>(a.sym[1]);
+            n += a.count;
+            pos += a.bits;
+            const DecodeEntry& b = t.primary[(w >> a.bits) & lowMask(kPrimaryBits)];
+            if (!b.count) break;
+            o[n] = static_cast<char>(b.sym[0]);
+            o[n + 1] = static_cast<char>(b.sym[1]);
+            n += b.count;
+            pos += b.bits;
         }
-    }
+        if (n >= total) break;
 
-    destroy(root);
+        std::uint64_t w = peekBits(data, size, pos);
+        const DecodeEntry& e = t.primary[w & lowMask(kPrimaryBits)];
+        if (e.count) {
+            o[n++] = static_cast<char>(e.sym[0]);
+            if (e.count == 2 && n < total) {
+                o[n++] = static_cast<char>(e.sym[1]);
+                pos += e.bits;
+            } else {
+                pos += e.first;
+            }
+            continue;
+        }
+        if (e.link == kNoLink) break; // not a code: corrupt stream
+        const DecodeEntry& s = t.sub[e.link + ((w >> kPrimaryBits) & lowMask(e.bits))];
+        if (!s.count) break;
+        o[n++] = static_cast<char>(s.sym[0]);
+        pos += kPrimaryBits + s.first;
+    }
+    if (pos > bitLen && n > 0) n--; // last symbol ran into the padding
+    out.resize(static_cast<std::size_t>(n));
     return out;
 }
 
-// File format (simple):
-// [256 uint32 freq][uint32 bitLen][uint32 dataBytes][data...]
-bool Huffman::saveToFile(const std::string& path, const HuffmanBlob& blob) {
-    std::ofstream f(path, std::ios::binary);
-    if (!f) return false;
+// Serialized format:
+// "ACHF" | u8 version | varint symbols | varint bitLen | code lengths | data
+// Code lengths are 4-bit values for bytes 0..255, two per byte, low nibble
+// first: 1..15 is a length, 0 then two nibbles r is a run of r+1 unused
+// bytes. The nibble stream is padded to a whole byte. data is
+// ceil(bitLen / 8) bytes. Varints are LEB128.
+
+static const char kHufMagic[4] = {'A','C','H','F'};
+static const std::uint8_t kHufVersion = 1;
+
+void Huffman::writeVarint(std::ostream& out, std::uint64_t x) {
+    while (x >= 0x80) { out.put(static_cast<char>((x & 0x7f) | 0x80)); x >>= 7; }
+    out.put(static_cast<char>(x));
+}
 
-    for (int i=0;i<256;i++) {
-        std::uint32_t x = blob.freq[i];
-        f.write(reinterpret_cast<const char*>(&x), sizeof(x));
+bool Huffman::readVarint(std::istream& in, std::uint64_t& x) {
+    x = 0;
+    for (int shift=0; shift<64; shift+=7) {
+        int c = in.get();
+        if (c == EOF) return false;
+        x |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+        if (!(c & 0x80)) return true;
     }
-    f.write(reinterpret_cast<const char*>(&blob.bitLen), sizeof(blob.bitLen));
-    std::uint32_t n = static_cast<std::uint32_t>(blob.data.size());
-    f.write(reinterpret_cast<const char*>(&n), sizeof(n));
-    if (n) f.write(reinterpret_cast<const char*>(blob.data.data()), n);
-    return true;
+    return false;
 }
 
-std::optional<HuffmanBlob> Huffman::loadFromFile(const std::string& path) {
-    std::ifstream f(path, std::ios::binary);
-    if (!f) return std::nullopt;
+bool Huffman::write(std::ostream& out, const HuffmanBlob& blob) {
+    if (blob.lengths.size() != 256) return false;
+    out.write(kHufMagic, sizeof(kHufMagic));
+    out.put(static_cast<char>(kHufVersion));
+    writeVarint(out, blob.symbols);
+    writeVarint(out, blob.bitLen);
 
-    HuffmanBlob blob;
-    blob.freq.assign(256, 0);
-    for (int i=0;i<256;i++) {
-        std::uint32_t x=0;
-        f.read(reinterpret_cast<char*>(&x), sizeof(x));
-        if (!f) return std::nullopt;
-        blob.freq[i]=x;
-    }
-    f.read(reinterpret_cast<char*>(&blob.bitLen), sizeof(blob.bitLen));
-    if (!f) return std::nullopt;
+    std::vector<std::uint8_t> nibbles;
+    for (int s=0; s<256; ) {
+        if (blob.lengths[s]) { nibbles.push_back(blob.lengths[s]); s++; continue; }
+        int run = 0;
+        while (s + run < 256 && !blob.lengths[s + run]) run++;
+        nibbles.push_back(0);
+        nibbles.push_back(static_cast<std::uint8_t>((run - 1) & 0xf));
+        nibbles.push_back(static_cast<std::uint8_t>((run - 1) >> 4));
+        s += run;
+    }
+    for (std::size_t i=0; i<nibbles.size(); i+=2) {
+        std::uint8_t hi = i + 1 < nibbles.size() ? nibbles[i + 1] : 0;
+        out.put(static_cast<char>(nibbles[i] | (hi << 4)));
+    }
 
-    std::uint32_t n=0;
-    f.read(reinterpret_cast<char*>(&n), sizeof(n));
-    if (!f) return std::nullopt;
+    std::size_t bytes = (static_cast<std::size_t>(blob.bitLen) + 7) / 8;
+    if (bytes > blob.data.size()) return false;
+    if (bytes) out.write(reinterpret_cast<const char*>(blob.data.data()), static_cast<std::streamsize>(bytes));
+    return static_cast<bool>(out);
+}
 
-    blob.data.resize(n);
-    if (n) f.read(reinterpret_cast<char*>(blob.data.data()), n);
-    if (!f) return std::nullopt;
+std::optional<HuffmanBlob> Huffman::read(std::istream& in) {
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kHufMagic, sizeof(magic)) != 0) return std::nullopt;
+    if (in.get() != kHufVersion) return std::nullopt;
+
+    HuffmanBlob blob;
+    std::uint64_t bitLen = 0;
+    if (!readVarint(in, blob.symbols) || !readVarint(in, bitLen)) return std::nullopt;
+    if (blob.symbols > bitLen) return std::nullopt;
+    blob.bitLen = bitLen;
 
+    blob.lengths.assign(256, 0);
+    int pending = -1; // buffered high nibble
+    auto nibble = [&]() -> int {
+        if (pending >= 0) { int v = pending; pending = -1; return v; }
+        int c = in.get();
+        if (c == EOF) return -1;
+        pending = (c >> 4) & 0xf;
+        return c & 0xf;
+    };
+    for (int s=0; s<256; ) {
+        int v = nibble();
+        if (v < 0) return std::nullopt;
+        if (v) { blob.lengths[s++] = static_cast<std::uint8_t>(v); continue; }
+        int lo = nibble(), hi = nibble();
+        if (lo < 0 || hi < 0) return std::nullopt;
+        int run = (lo | (hi << 4)) + 1;
+        if (s + run > 256) return std::nullopt;
+        s += run;
+    }
+    std::vector<std::uint32_t> codes;
+    if (!canonicalCodes(blob.lengths, codes)) return std::nullopt;
+
+    // grow as bytes actually arrive, so a corrupt bitLen cannot demand
+    // a huge allocation up front
+    const std::uint64_t bytes = (bitLen + 7) / 8;
+    const std::uint64_t kChunk = 1 << 20;
+    while (blob.data.size() < bytes) {
+        std::size_t at = blob.data.size();
+        std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(kChunk, bytes - at));
+        blob.data.resize(at + n);
+        if (!in.read(reinterpret_cast<char*>(blob.data.data() + at), static_cast<std::streamsize>(n))) return std::nullopt;
+    }
     return blob;
 }
 
+bool Huffman::saveToFile(const std::string& path, const HuffmanBlob& blob) {
+    std::ofstream f(path, std::ios::binary);
+    if (!f) return false;
+    return write(f, blob);
+}
+
+std::optional<HuffmanBlob> Huffman::loadFromFile(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return std::nullopt;
+    return read(f);
+}
@@ -1,40 +1,51 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 #include <optional>
+#include <istream>
+#include <ostream>
 
 // Minimal Huffman coding for learning:
-// - compress(std::string) -> bytes + frequency header
-// - decompress(bytes) -> original string
+// - compress(std::string) -> bytes + code-length header; codes are shifted
+//   into a 64-bit accumulator and stored a word at a time
+// - decompress(bytes) -> original string; table driven: each lookup on
+//   the next 11 bits yields up to two symbols, longer codes go through a
+//   second-level table
+// - canonical codes: the code lengths alone define the codes, so that is
+//   all the header stores. Lengths are capped at kMaxCodeLen.
 
 struct HuffmanBlob {
-    std::vector<std::uint32_t> freq;  // size 256
-    std::vector<std::uint8_t> data;   // bit-packed stream (with bitLen)
-    std::uint32_t bitLen{0};
+    std::vector<std::uint8_t> lengths; // size 256, code length per byte value (0 = unused)
+    std::vector<std::uint8_t> data;    // bit-packed stream (with bitLen)
+    std::uint64_t bitLen{0};
+    std::uint64_t symbols{0};          // decoded size in bytes
 };
 
 class Huffman {
 public:
-    static HuffmanBlob compress(const std::string& input);
+    static const int kMaxCodeLen = 15;
+
+    static HuffmanBlob compress(std::string_view input);
     static std::string decompress(const HuffmanBlob& blob);
 
+    // Serialized form (see Huffman.cpp). Files written before the switch to
+    // canonical codes (256 frequencies up front) are no longer readable.
+    static bool write(std::ostream& out, const HuffmanBlob& blob);
+    static std::optional<HuffmanBlob> read(std::istream& in);
+
     static bool saveToFile(const std::string& path, const HuffmanBlob& blob);
     static std::optional<HuffmanBlob> loadFromFile(const std::string& path);
 
+    // LEB128 varints, as used by the blob header (and the FileIO archive).
+    static void writeVarint(std::ostream& out, std::uint64_t x);
+    static bool readVarint(std::istream& in, std::uint64_t& x);
+
 private:
-    struct Node {
-        int ch; // -1 internal, 0..255 leaf
-        std::uint64_t f;
-        Node* left{nullptr};
-        Node* right{nullptr};
-    };
-
-    static Node* buildTree(const std::vector<std::uint32_t>& freq);
-    static void buildCodes(Node* n, std::vector<std::vector<bool>>& codes, std::vector<bool>& cur);
-    static void destroy(Node* n);
-
-    static void writeBits(const std::vector<bool>& bits, std::vector<std::uint8_t>& out, std::uint32_t& bitLen);
-    static bool readBit(const std::vector<std::uint8_t>& in, std::uint32_t i);
+    // Length-limited code lengths for the given byte counts.
+    static std::vector<std::uint8_t> codeLengths(const std::vector<std::uint64_t>& freq);
+    // Canonical code per symbol, bit-reversed (first bit in bit 0) to match
+    // the LSB-first stream; false if the lengths do not form a prefix code.
+    static bool canonicalCodes(const std::vector<std::uint8_t>& lengths, std::vector<std::uint32_t>& codes);
 };
-
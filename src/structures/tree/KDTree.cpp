@@ -0,0 +1,82 @@
+#include "structures/tree/KDTree.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <limits>
+
+static double coordOf(const KDTree::Point& p, int axis) { return axis == 0 ? p.x : p.y; }
+
+void KDTree::build(std::vector<Point> pts) {
+    pts_ = std::move(pts);
+    axis_.assign(pts_.size(), 0);
+    build(0, pts_.size());
+}
+
+void KDTree::build(std::size_t lo, std::size_t hi) {
+    if (hi - lo <= 1) return;
+    double minX = pts_[lo].x, maxX = minX, minY = pts_[lo].y, maxY = minY;
+    for (std::size_t i=lo+1; i<hi; i++) {
+        minX = std::min(minX, pts_[i].x); maxX = std::max(maxX, pts_[i].x);
+        minY = std::min(minY, pts_[i].y); maxY = std::max(maxY, pts_[i].y);
+    }
+    int axis = (maxY - minY > maxX - minX) ? 1 : 0;
+    std::size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(pts_.begin() + lo, pts_.begin() + mid, pts_.begin() + hi,
+                     [axis](const Point& a, const Point& b) { return coordOf(a, axis) < coordOf(b, axis); });
+    axis_[mid] = static_cast<unsigned char>(axis);
+    build(lo, mid);
+    build(mid + 1, hi);
+}
+
+int KDTree::nearest(double x, double y) const {
+    int best = -1;
+    double bestD2 = std::numeric_limits<double>::infinity();
+    nearest(0, pts_.size(), x, y, best, bestD2);
+    return best;
+}
+
+void KDTree::nearest(std::size_t lo, std::size_t hi, double x, double y, int& best, double& bestD2) const {
+    if (lo >= hi) return;
+    std::size_t mid = lo + (hi - lo) / 2;
+    const Point& p = pts_[mid];
+    double dx = p.x - x, dy = p.y - y;
+    double d2 = dx * dx + dy * dy;
+    if (d2 < bestD2) { bestD2 = d2; best = p.id; }
+
+    double diff = (axis_[mid] == 0) ? x - p.x : y - p.y;
+    // near side first; the far side only if the splitting line is closer than the best hit
+    if (diff < 0) {
+        nearest(lo, mid, x, y, best, bestD2);
+        if (diff * diff < bestD2) nearest(mid + 1, hi, x, y, best, bestD2);
+    } else {
+        nearest(mid + 1, hi, x, y, best, bestD2);
+        if (diff * diff < bestD2) nearest(lo, mid, x, y, best, bestD2);
+    }
+}
+
+std::vector<int> KDTree::withinBox(double minX, double minY, double maxX, double maxY) const {
+    std::vector<int> out;
+    withinBox(0, pts_.size(), minX, minY, maxX, maxY, out);
+    return out;
+}
+
+void KDTree::withinBox(std::size_t lo, std::size_t hi, double minX, double minY, double maxX, double maxY,
+                       std::vector<int>& out) const {
+    if (lo >= hi) return;
+    std::size_t mid = lo + (hi - lo) / 2;
+    const Point& p = pts_[mid];
+    if (p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY) out.push_back(p.id);
+
+    double c = coordOf(p, axis_[mid]);
+    double lowEdge = (axis_[mid] == 0) ? minX : minY;
+    double highEdge = (axis_[mid] == 0) ? maxX : maxY;
+    if (lowEdge <= c) withinBox(lo, mid, minX, minY, maxX, maxY, out);
+    if (highEdge >= c) withinBox(mid + 1, hi, minX, minY, maxX, maxY, out);
+}
+
+std::vector<int> KDTree::nearestBatch(const std::vector<Point>& queries) const {
+    std::vector<int> out(queries.size(), -1);
+    Parallel::forRange(queries.size(), 4096, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i=b; i<e; i++) out[i] = nearest(queries[i].x, queries[i].y);
+    });
+    return out;
+}
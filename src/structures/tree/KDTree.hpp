@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// Static 2-d tree over (x, y, id) points for nearest-node snapping.
+// Stored implicitly in one array: the median of each range is its root,
+// split on the axis with the larger spread. Build O(n log n), nearest
+// O(log n) expected, box queries O(sqrt(n) + hits).
+class KDTree {
+public:
+    struct Point {
+        double x;
+        double y;
+        int id;
+    };
+
+    KDTree() = default;
+    explicit KDTree(std::vector<Point> pts) { build(std::move(pts)); }
+
+    void build(std::vector<Point> pts);
+    std::size_t size() const { return pts_.size(); }
+    bool empty() const { return pts_.empty(); }
+
+    int nearest(double x, double y) const; // id, -1 if empty
+    std::vector<int> withinBox(double minX, double minY, double maxX, double maxY) const;
+
+    // Snaps many points at once, spread over the worker pool.
+    std::vector<int> nearestBatch(const std::vector<Point>& queries) const;
+
+private:
+    std::vector<Point> pts_;
+    std::vector<unsigned char> axis_; // split axis of the node at each slot (0 = x, 1 = y)
+
+    void build(std::size_t lo, std::size_t hi);
+    void nearest(std::size_t lo, std::size_t hi, double x, double y, int& best, double& bestD2) const;
+    void withinBox(std::size_t lo, std::size_t hi, double minX, double minY, double maxX, double maxY,
+                   std::vector<int>& out) const;
+};